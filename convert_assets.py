@@ -0,0 +1,188 @@
+# Converts the PNG art in data/ to raw RGB332 bitmaps (".r8" files) that
+# the firmware can blit without inflating PNGs at runtime.  convert_data.py
+# runs this before building the filesystem image; it can also be run by
+# hand as "python convert_assets.py data out_dir".
+#
+# .r8 format, all values little-endian:
+#   0  'R' '8'
+#   2  flags: 1 = rows are run-length encoded, 2 = has a transparent color
+#   3  transparent color, valid if flags & 2
+#   4  width (uint16)
+#   6  height (uint16)
+#   8  rows of width RGB332 pixels, or if RLE, rows of (count, pixel)
+#      byte pairs with counts from 1 to 255
+#
+# Partially transparent pixels need the background they are drawn on.
+# Assets listed in MATTES are always drawn on that color, so they are
+# pre-blended onto it; other assets with partial alpha are left as PNG.
+
+import os
+import shutil
+import struct
+import sys
+import zlib
+
+# Floyd-Steinberg dither down to RGB332.  Off by default because the UI
+# art is mostly flat color: the PNG decoder on the device truncates
+# without dithering, so undithered output looks the same as before, and
+# it run-length encodes several times smaller.
+DITHER = False
+TRANSPARENT = 0xE3  # RGB332 magenta, used for fully transparent pixels
+
+# Background color under assets that are drawn on a known background
+MATTES = {
+    "filesbg.png": (0, 0, 0),
+    "jogbg.png": (0, 0, 0),
+    "fluid_dial.png": (0, 0, 0),
+}
+
+
+def read_png(path):
+    """Returns (width, height, rows of RGBA tuples) or None if unsupported"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        return None
+    pos = 8
+    idat = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos : pos + 8])
+        chunk = data[pos + 8 : pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+    if depth != 8 or interlace or color_type not in (2, 6):
+        return None
+    bpp = 4 if color_type == 6 else 3
+    raw = zlib.decompress(idat)
+    stride = width * bpp
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        filt = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1 : (y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if filt == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filt == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filt == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif filt == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        prev = line
+        if bpp == 4:
+            rows.append([tuple(line[i : i + 4]) for i in range(0, stride, 4)])
+        else:
+            rows.append([tuple(line[i : i + 3]) + (255,) for i in range(0, stride, 3)])
+    return width, height, rows
+
+
+def blend(rows, matte):
+    out = []
+    for row in rows:
+        line = []
+        for r, g, b, a in row:
+            line.append(tuple((v * a + m * (255 - a)) // 255 for v, m in zip((r, g, b), matte)) + (255,))
+        out.append(line)
+    return out
+
+
+def to_rgb332(width, height, rows):
+    """Returns (pixel rows, has_transparency) or None if alpha is partial"""
+    alphas = set(p[3] for row in rows for p in row)
+    if alphas - {0, 255}:
+        return None
+    work = [[list(p[:3]) for p in row] for row in rows]
+    out = []
+    for y in range(height):
+        line = bytearray(width)
+        for x in range(width):
+            if rows[y][x][3] == 0:
+                line[x] = TRANSPARENT
+                continue
+            r, g, b = (min(255, max(0, int(v))) for v in work[y][x])
+            q = (r >> 5) << 5 | (g >> 5) << 2 | b >> 6
+            if q == TRANSPARENT:
+                q ^= 1  # Keep real pixels distinct from the transparent color
+            line[x] = q
+            if DITHER:
+                qr, qg, qb = (q >> 5) * 255 // 7, ((q >> 2) & 7) * 255 // 7, (q & 3) * 255 // 3
+                err = (r - qr, g - qg, b - qb)
+                for dx, dy, k in ((1, 0, 7), (-1, 1, 3), (0, 1, 5), (1, 1, 1)):
+                    nx, ny = x + dx, y + dy
+                    if 0 <= nx < width and ny < height and rows[ny][nx][3]:
+                        for c in range(3):
+                            work[ny][nx][c] += err[c] * k / 16
+        out.append(line)
+    return out, 0 in alphas
+
+
+def rle(line):
+    out = bytearray()
+    i = 0
+    while i < len(line):
+        n = 1
+        while i + n < len(line) and n < 255 and line[i + n] == line[i]:
+            n += 1
+        out += bytes((n, line[i]))
+        i += n
+    return out
+
+
+def convert_png(src, dst):
+    """Writes dst as .r8 and returns its size, or returns None"""
+    png = read_png(src)
+    if not png:
+        return None
+    width, height, rows = png
+    matte = MATTES.get(os.path.basename(src))
+    if matte:
+        rows = blend(rows, matte)
+    converted = to_rgb332(width, height, rows)
+    if not converted:
+        return None
+    lines, transparent = converted
+    raw = b"".join(lines)
+    packed = b"".join(rle(line) for line in lines)
+    flags = 2 if transparent else 0
+    if len(packed) < len(raw):
+        flags |= 1
+        raw = packed
+    with open(dst, "wb") as f:
+        f.write(struct.pack("<2sBBHH", b"R8", flags, TRANSPARENT, width, height))
+        f.write(raw)
+    return 8 + len(raw)
+
+
+def convert_dir(src_dir, dst_dir):
+    """Copies src_dir to dst_dir, adding an .r8 next to each convertible PNG"""
+    if os.path.exists(dst_dir):
+        shutil.rmtree(dst_dir)
+    shutil.copytree(src_dir, dst_dir)
+    for name in sorted(os.listdir(src_dir)):
+        if not name.lower().endswith(".png"):
+            continue
+        dst = os.path.join(dst_dir, name[:-4] + ".r8")
+        size = convert_png(os.path.join(src_dir, name), dst)
+        if size:
+            print("Asset %s -> %s (%d bytes)" % (name, os.path.basename(dst), size))
+        else:
+            print("Asset %s left as PNG" % name)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("Usage: python convert_assets.py data_dir out_dir")
+        sys.exit(1)
+    convert_dir(sys.argv[1], sys.argv[2])
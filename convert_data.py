@@ -0,0 +1,16 @@
+# Filesystem images are built from a copy of data/ in which PNG art also
+# has raw RGB332 versions that draw without PNG decoding at runtime.
+# This must be a "pre:" extra script: the platform builder makes the
+# filesystem target from PROJECT_DATA_DIR when it loads, so a change
+# made by a post script would be too late to be used.
+Import("env")
+
+import sys
+
+if any(target in COMMAND_LINE_TARGETS for target in ("buildfs", "uploadfs")):
+    sys.path.insert(0, env.subst("$PROJECT_DIR"))
+    from convert_assets import convert_dir
+
+    assets_dir = env.subst("$BUILD_DIR/assets")
+    convert_dir(env.subst("$PROJECT_DATA_DIR"), assets_dir)
+    env.Replace(PROJECT_DATA_DIR=assets_dir)
@@ -14,7 +14,7 @@ static const int MIN_BRIGHTNESS = 8;
 void AboutScene::onEntry(void* arg) {
     getBrightness();
 
-    if (state != Disconnected) {
+    if (model().state != Disconnected) {
         send_line("$G");
         send_line("$I");
     }
@@ -28,28 +28,43 @@ void AboutScene::onGreenButtonPress() {
     esp_restart();
 #endif
 }
+#if defined(USE_M5) && defined(ARDUINO)
+// Dims the display while the wakeup hint shows, then sleeps
+static Tween      sleep_fade;
+static timer_id_t sleep_timer = 0;
+
+static void fade_to_sleep(void* arg) {
+    display.setBrightness(sleep_fade.value());
+    if (!sleep_fade.running()) {
+        cancel_timer(sleep_timer);
+        deep_sleep(0);
+    }
+}
+#endif
+
 void AboutScene::onRedButtonPress() {
 #ifdef USE_M5
     set_disconnected_state();
-#ifdef ARDUINO
 #    ifdef ARDUINO
-    centered_text("Use red button to wakeup", 118+40, RED, TINY);
+    centered_label("Use red button to wakeup", 118 + 40, RED, TINY);
     refreshDisplay();
-    delay_ms(2000);
-
-    deep_sleep(0);
+    if (!sleep_timer) {
+        // Not owned by the scene, so leaving it does not cancel the sleep
+        sleep_fade.start(_brightness, 0, 2000);
+        sleep_timer = set_interval(UPDATE_RATE_MS, fade_to_sleep);
+    }
 #    else
     dbg_println("Sleep");
 #    endif
 #else
     next_layout(1);
-    reDisplay();
+    invalidate();
 #endif
 }
 
 void AboutScene::onTouchClick() {
     fnc_realtime(StatusReport);
-    if (state == Idle) {
+    if (model().state == Idle) {
         send_line("$G");
         send_line("$I");
     }
@@ -64,7 +79,7 @@ void AboutScene::onEncoder(int delta) {
         display.setBrightness(--_brightness);
         setPref("brightness", _brightness);
     }
-    reDisplay();
+    invalidate();
 }
 void AboutScene::onStateChange(state_t old_state) {
     reDisplay();
@@ -84,12 +99,12 @@ void AboutScene::reDisplay() {
     refreshDisplay();
     y += 10;
 #ifdef FNC_BAUD  // FNC_BAUD might not be defined for Windows
-    text("FNC baud:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
+    label("FNC baud:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
     text(intToCStr(FNC_BAUD), val_x, y, GREEN, TINY, bottom_left);
 #endif
 
 #ifndef DEBUG_TO_USB  // backlight shares a pin with this
-    text("Brightness:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
+    label("Brightness:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
     text(intToCStr(_brightness), val_x, y, GREEN, TINY, bottom_left);
 #endif
 
@@ -97,8 +112,8 @@ void AboutScene::reDisplay() {
     #include "Hardware2432.hpp"
 
     if (!i2c_expander_connected()) {
-        text("PCF8574 not detected", 20, y += y_spacing, RED, TINY, bottom_left);
-        text("I2C addr:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
+        label("PCF8574 not detected", 20, y += y_spacing, RED, TINY, bottom_left);
+        label("I2C addr:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
         text(intToCStr(I2C_BUTTONS_ADDR), val_x, y, GREEN, TINY, bottom_left);
     }
 #endif
@@ -16,3 +16,24 @@
 
 // Automatically leave Homing Scene after homing is finished
 // #define AUTO_HOMING_RETURN
+
+// Extrapolate DRO positions between status reports while the machine
+// is moving, so the display looks continuous at the normal report rate
+// #define INTERPOLATE_DRO
+
+// Log how long each background image takes to draw, to compare the
+// raw bitmaps made by convert_assets.py with PNG decoding
+// #define SHOW_ASSET_TIMES
+
+// Use a 4-bit canvas with a fixed 16-color theme palette instead of an
+// 8-bit one.  Halves the RAM of the canvas and full-screen backgrounds,
+// at the cost of quantizing images to the theme colors.  ESP32 only.
+// #define PALETTE_CANVAS
+
+// Push each frame by DMA from an RGB565 copy of the canvas while the
+// next frame renders.  The copy takes 2 bytes a pixel (113 KB for a
+// 240x240 canvas) and is skipped if that would leave little RAM free.
+// #define DMA_TRANSFER
+
+// Animate scrolling in the file list and the macro menu
+// #define SMOOTH_SCROLL
@@ -1,21 +1,291 @@
 #include "ConfigItem.h"
 #include "Scene.h"
+#include "NVS.h"
+#include <unordered_map>
 
-std::vector<ConfigItem*> configRequests;
+// Keyed by the full name, e.g. "$/axes/x/homing/cycle"
+static std::unordered_map<std::string, ConfigItem*> config_items;
+
+void register_config_item(ConfigItem* item) {
+    config_items[item->name()] = item;
+}
+
+static bool set_config_item(const std::string& name, const char* value) {
+    auto it = config_items.find(name);
+    if (it == config_items.end()) {
+        return false;
+    }
+    it->second->got(value);
+    return true;
+}
 
 void parse_dollar(const char* line) {
-    for (auto it = configRequests.begin(); it != configRequests.end(); ++it) {
-        auto item = *it;
+    const char* value = strchr(line, '=');
+    if (!value) {
+        return;
+    }
+    if (set_config_item(std::string(line, value - line), value + 1)) {
+        post_event(ConfigArrivedEvent);
+    }
+}
+
+// State of the subtree query in progress
+static bool        tree_active = false;
+static uint32_t    tree_ack;       // lines_acked() when the query is answered
+static std::string tree_root;      // e.g. "$/axes"
+static std::string tree_root_key;  // e.g. "axes"
+static const int   max_tree_depth = 8;
+static int         tree_indents[max_tree_depth];
+static std::string tree_keys[max_tree_depth];
+static int         tree_depth = 0;
+static int         tree_found = 0;
+static timer_id_t  tree_timer = 0;
+
+static void end_config_tree();
+
+// In case the answer never comes, e.g. if the line was lost
+static void config_tree_timeout(void* arg) {
+    tree_timer = 0;
+    dbg_printf("%s: no answer\n", tree_root.c_str());
+    end_config_tree();
+}
+
+void request_config_tree(const char* path) {
+    const char* slash = strrchr(path, '/');
+
+    send_line(path);
+    tree_active   = true;
+    tree_ack      = lines_sent();
+    tree_root     = path;
+    tree_root_key = slash ? slash + 1 : path;
+    tree_depth    = 0;
+    tree_found    = 0;
+    cancel_timer(tree_timer);
+    tree_timer = set_timeout(5000, config_tree_timeout);
+}
+
+// The header line names the root, as "axes:", "/axes:" or "$/axes:"
+static bool is_tree_header(const char* line) {
+    const char* colon = strchr(line, ':');
+    if (!colon || colon[1] != '\0') {
+        return false;
+    }
+    std::string name(line, colon - line);
+    return name == tree_root_key || name == tree_root || "$" + name == tree_root;
+}
+
+// Lines look like "  homing:" for a section or "    cycle: 2" for a value,
+// with the nesting given by the indentation.  Unindented lines other
+// than the header are not part of the reply, e.g. [MSG:...] lines.
+bool parse_config_tree_line(const char* line) {
+    if (!tree_active) {
+        return false;
+    }
+    int indent = 0;
+    while (line[indent] == ' ') {
+        ++indent;
+    }
+    if (indent == 0) {
+        return tree_depth == 0 && tree_found == 0 && is_tree_header(line);
+    }
+    const char* key   = line + indent;
+    const char* colon = strchr(key, ':');
+    if (!colon || colon == key) {
+        return true;
+    }
+    std::string name(key, colon - key);
 
-        size_t cmdlen = strlen(item->name());
+    while (tree_depth && tree_indents[tree_depth - 1] >= indent) {
+        --tree_depth;
+    }
 
-        if (strncmp(line, item->name(), cmdlen) == 0 && line[cmdlen] == '=') {
-            line += cmdlen + 1;
-            item->got(line);
+    const char* value = colon + 1;
+    while (*value == ' ') {
+        ++value;
+    }
+    if (*value == '\0') {
+        if (tree_depth < max_tree_depth) {
+            tree_indents[tree_depth] = indent;
+            tree_keys[tree_depth]    = name;
+            ++tree_depth;
+        }
+        return true;
+    }
 
-            current_scene->reDisplay();
-            configRequests.erase(it);
-            break;
+    std::string path = tree_root;
+    for (int i = 0; i < tree_depth; i++) {
+        path += '/';
+        path += tree_keys[i];
+    }
+    path += '/';
+    path += name;
+    if (set_config_item(path, value)) {
+        ++tree_found;
+    }
+    return true;
+}
+
+static void save_config_cache();
+
+static void end_config_tree() {
+    if (!tree_active) {
+        return;
+    }
+    tree_active = false;
+    cancel_timer(tree_timer);
+    tree_timer = 0;
+    dbg_printf("%s: %d config items\n", tree_root.c_str(), tree_found);
+    if (tree_found) {
+        save_config_cache();
+        post_event(ConfigArrivedEvent);
+        return;
+    }
+    // Older firmware, or a reply in a format we do not know.  Ask for
+    // the items one at a time instead, keeping any cached values until
+    // the answers arrive.
+    for (auto& entry : config_items) {
+        ConfigItem* item = entry.second;
+        if (strncmp(item->name(), tree_root.c_str(), tree_root.length()) == 0) {
+            item->query();
         }
     }
 }
+
+static bool     identity_pending = false;
+static uint32_t identity_ack;  // lines_acked() when $I is answered
+
+static void use_identity();
+
+void config_line_acked() {
+    if (tree_active && (int32_t)(lines_acked() - tree_ack) >= 0) {
+        end_config_tree();
+    }
+    if (identity_pending && (int32_t)(lines_acked() - identity_ack) >= 0) {
+        use_identity();
+    }
+}
+
+static StringConfigItem config_filename("$Config/Filename");
+
+static std::string  controller_version;
+static std::string  controller_id;
+static nvs_handle_t cache_nvs {};
+static std::string  sync_path;
+static timer_id_t   sync_timer = 0;
+
+void set_controller_version(const char* version) {
+    controller_version = version;
+}
+
+// NVS keys are limited to 15 characters, so items are stored by hash
+static const char* cache_key(const char* name) {
+    static char key[12];
+    uint32_t    hash = 2166136261u;  // FNV-1a
+    while (*name) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+    snprintf(key, sizeof(key), "c%08x", (unsigned)hash);
+    return key;
+}
+
+static bool open_config_cache() {
+    if (!cache_nvs) {
+        cache_nvs = nvs_init("config");
+    }
+    return cache_nvs;
+}
+
+static void save_config_cache() {
+    if (controller_id.empty() || !open_config_cache()) {
+        return;
+    }
+    char   cached[64];
+    size_t len;
+    for (auto& entry : config_items) {
+        ConfigItem* item = entry.second;
+        if (!item->known()) {
+            continue;
+        }
+        // Avoid flash writes when nothing changed
+        len       = sizeof(cached);
+        cached[0] = '\0';
+        nvs_get_str(cache_nvs, cache_key(item->name()), cached, &len);
+        if (strcmp(cached, item->text()) != 0) {
+            nvs_set_str(cache_nvs, cache_key(item->name()), item->text());
+        }
+    }
+    nvs_set_str(cache_nvs, "id", controller_id.c_str());
+}
+
+// Applies the cached values if they belong to this controller
+static bool load_config_cache(const char* path) {
+    if (controller_id.empty() || !open_config_cache()) {
+        return false;
+    }
+    char   cached[64];
+    size_t len = sizeof(cached);
+    cached[0]  = '\0';
+    nvs_get_str(cache_nvs, "id", cached, &len);
+    if (controller_id != cached) {
+        return false;
+    }
+    size_t pathlen = strlen(path);
+    int    found   = 0;
+    for (auto& entry : config_items) {
+        ConfigItem* item = entry.second;
+        if (strncmp(item->name(), path, pathlen) != 0) {
+            continue;
+        }
+        len       = sizeof(cached);
+        cached[0] = '\0';
+        nvs_get_str(cache_nvs, cache_key(item->name()), cached, &len);
+        if (*cached) {
+            item->got(cached);
+            ++found;
+        }
+    }
+    return found;
+}
+
+static void verify_config_tree(void* arg) {
+    sync_timer = 0;
+    request_config_tree(sync_path.c_str());
+}
+
+// Called when $I is answered, so the [VER:] line and the config
+// filename that were asked for before it have arrived
+static void use_identity() {
+    identity_pending = false;
+    cancel_timer(sync_timer);
+    sync_timer = 0;
+
+    controller_id.clear();
+    if (config_filename.known() && !controller_version.empty()) {
+        controller_id = controller_version + ":" + config_filename.get();
+    }
+
+    if (load_config_cache(sync_path.c_str())) {
+        dbg_printf("Using cached config for %s\n", controller_id.c_str());
+        post_event(ConfigArrivedEvent);
+        sync_timer = set_timeout(1000, verify_config_tree);
+    } else {
+        request_config_tree(sync_path.c_str());
+    }
+}
+
+// In case $I is never answered
+static void identity_timeout(void* arg) {
+    sync_timer = 0;
+    use_identity();
+}
+
+void sync_config_tree(const char* path) {
+    controller_version.clear();
+    config_filename.request();
+    send_line("$I");
+    sync_path        = path;
+    identity_ack     = lines_sent();
+    identity_pending = true;
+    cancel_timer(sync_timer);
+    sync_timer = set_timeout(5000, identity_timeout);
+}
@@ -1,15 +1,15 @@
-#include <vector>
 #include <string>
 #include <cstring>
 #include "FluidNCModel.h"
 
 class ConfigItem;
-extern std::vector<ConfigItem*> configRequests;
+void register_config_item(ConfigItem* item);
 
 class ConfigItem {
 private:
     const char* _name;
     bool        _known;
+    std::string _text;  // The value as received, for the config cache
 
 public:
     ConfigItem(const char* name) : _name(name), _known(false) {}
@@ -17,15 +17,24 @@ public:
     virtual void set(const char* s) = 0;
     const char*  name() { return _name; }
     bool         known() { return _known; }
-    void         init() {
+    // Forget the value and wait for it to arrive, either in answer
+    // to request() or as part of request_config_tree()
+    void init() {
         _known = false;
-        configRequests.push_back(this);
-        send_line(_name);
+        register_config_item(this);
     }
+    void request() {
+        init();
+        query();
+    }
+    // Asks for the value again, keeping the current one until it arrives
+    void query() { send_line(_name); }
     void got(const char* s) {
         _known = true;
+        _text  = s;
         set(s);
     }
+    const char* text() { return _text.c_str(); }
 };
 
 class IntConfigItem : public ConfigItem {
@@ -69,3 +78,19 @@ public:
 };
 
 void parse_dollar(const char* line);
+
+// Gets every item under a path like "$/axes" in one round trip.
+// The YAML reply is routed through parse_config_tree_line() until the
+// ok or error that answers the query.  If the reply sets no items, they
+// are requested one by one.
+void request_config_tree(const char* path);
+bool parse_config_tree_line(const char* line);  // False if the line is not part of a reply
+void config_line_acked();                       // Called on every ok or error
+
+// Like request_config_tree(), but first applies the values cached in NVS
+// for this controller.  The cache is keyed by the controller's $I version
+// and config filename, so the choice is made when $I is answered.  When
+// they match, the query that verifies the cached values is sent a little
+// later, so the UI is usable as soon as the controller is identified.
+void sync_config_tree(const char* path);
+void set_controller_version(const char* version);  // From the $I [VER:] line
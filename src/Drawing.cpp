@@ -3,13 +3,26 @@
 
 #include "System.h"
 #include "Drawing.h"
+#include "Scene.h"
 #include "alarm.h"
+#include "Spans.h"
+#include <algorithm>
+#include <cmath>
 #include <map>
+#if defined(DMA_TRANSFER) && defined(ARDUINO)
+#    include <esp_heap_caps.h>
+#endif
 
 void drawBackground(int color) {
     canvas.fillSprite(color);
 }
 
+void restoreBackground(int x, int y, int w, int h) {
+    canvas.setClipRect(x, y, w, h);
+    system_background();
+    canvas.clearClipRect();
+}
+
 void drawFilledCircle(int x, int y, int radius, int fillcolor) {
     canvas.fillCircle(x, y, radius, fillcolor);
 }
@@ -18,10 +31,24 @@ void drawFilledCircle(Point xy, int radius, int fillcolor) {
     drawFilledCircle(dispxy.x, dispxy.y, radius, fillcolor);
 }
 
+// Draws the spans from Spans.h as lines on the canvas
+struct canvas_fill {
+    int x;
+    int y;
+    int color;
+    void operator()(int dy, int left, int right) const { canvas.drawFastHLine(x + left, y + dy, right - left + 1, color); }
+};
+
+void drawRing(int x, int y, int outer, int inner, int color) {
+    ring_spans(outer, inner, canvas_fill { x, y, color });
+}
+
+void drawThickArc(int x, int y, int outer, int inner, int start_angle, int end_angle, int color) {
+    arc_spans(outer, inner, start_angle, end_angle, canvas_fill { x, y, color });
+}
+
 void drawCircle(int x, int y, int radius, int thickness, int outlinecolor) {
-    for (int i = 0; i < thickness; i++) {
-        canvas.drawCircle(x, y, radius - i, outlinecolor);
-    }
+    drawRing(x, y, radius, radius - thickness + 1, outlinecolor);
 }
 void drawCircle(Point xy, int radius, int thickness, int outlinecolor) {
     Point dispxy = xy.to_display();
@@ -72,10 +99,80 @@ LGFX_Sprite* createPngBackground(const char* filename) {
     LGFX_Sprite* sprite = new LGFX_Sprite(&canvas);
     sprite->setColorDepth(canvas.getColorDepth());
     sprite->createSprite(canvas.width(), canvas.height());
+    useThemePalette(sprite);
     drawPngFile(sprite, filename, 0, 0);
+    dbg_printf("%s background: %d bytes at %d bits\n", filename, sprite->bufferLength(), sprite->getColorDepth() & 0xff);
     return sprite;
 }
 
+#ifdef PALETTE_CANVAS
+// RGB888 values of the color indices in System.h
+static const uint32_t theme_palette[16] = {
+    0x000000,  // BLACK
+    0x000000,  // NO_BG
+    0xFFFFFF,  // WHITE
+    0xFF0000,  // RED
+    0xFFFF00,  // YELLOW
+    0x0000FF,  // BLUE
+    0xD0D0D0,  // LIGHTGREY
+    0x787878,  // DARKGREY
+    0x00FF00,  // GREEN
+    0x000078,  // NAVY
+    0x00FFFF,  // CYAN
+    0xFFB400,  // ORANGE
+    0x984C00,  // BROWN
+    0x780000,  // MAROON
+    0xFF00FF,  // MAGENTA
+    0xFFFF80,  // LIGHTYELLOW
+};
+
+void useThemePalette(LGFX_Sprite* sprite) {
+    sprite->createPalette(theme_palette, 16);
+}
+int themeColor565(int color) {
+    uint32_t rgb = theme_palette[color & 15];
+    return lgfx::color565(rgb >> 16, (rgb >> 8) & 0xff, rgb & 0xff);
+}
+int themeColor332(uint8_t rgb332) {
+    static int8_t nearest[256];
+    static bool   made = false;
+    if (!made) {
+        for (int c = 0; c < 256; c++) {
+            int r = (c >> 5) * 255 / 7;
+            int g = ((c >> 2) & 7) * 255 / 7;
+            int b = (c & 3) * 255 / 3;
+            // Skip index 1, the NO_BG black, and 14, the transparent color
+            int best   = 0;
+            int best_d = 1 << 30;
+            for (int i = 0; i < 16; i++) {
+                if (i == 1 || i == MAGENTA) {
+                    continue;
+                }
+                int dr = r - (int)(theme_palette[i] >> 16);
+                int dg = g - (int)((theme_palette[i] >> 8) & 0xff);
+                int db = b - (int)(theme_palette[i] & 0xff);
+                int d  = 3 * dr * dr + 4 * dg * dg + 2 * db * db;
+                if (d < best_d) {
+                    best   = i;
+                    best_d = d;
+                }
+            }
+            nearest[c] = best;
+        }
+        made = true;
+    }
+    return nearest[rgb332];
+}
+#else
+void useThemePalette(LGFX_Sprite* sprite) {}
+int  themeColor565(int color) {
+    return color;
+}
+int themeColor332(uint8_t rgb332) {
+    return lgfx::color565((rgb332 >> 5) * 255 / 7, ((rgb332 >> 2) & 7) * 255 / 7, (rgb332 & 3) * 255 / 3);
+}
+#endif
+
 // We use 1 to mean no background
 // 1 is visually indistinguishable from black so losing that value is unimportant
 #define NO_BG 1
@@ -118,16 +215,18 @@ void drawStatus() {
     static constexpr int width  = 140;
     static constexpr int height = 36;
 
-    int bgColor = stateBGColors[state];
+    const ModelSnapshot& m = model();
+
+    int bgColor = stateBGColors[m.state];
     if (bgColor != 1) {
         canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
     }
-    int fgColor = stateFGColors[state];
-    if (state == Alarm) {
-        centered_text(my_state_string, y + height / 2 - 4, fgColor, SMALL);
-        centered_text(alarm_name_short[lastAlarm], y + height / 2 + 12, fgColor);
+    int fgColor = stateFGColors[m.state];
+    if (m.state == Alarm) {
+        centered_label(m.state_string, y + height / 2 - 4, fgColor, SMALL);
+        centered_label(alarm_name_short[lastAlarm], y + height / 2 + 12, fgColor);
     } else {
-        centered_text(my_state_string, y + height / 2 + 3, fgColor, MEDIUM);
+        centered_label(m.state_string, y + height / 2 + 3, fgColor, MEDIUM);
     }
 }
 
@@ -135,22 +234,26 @@ void drawStatusTiny(int y) {
     static constexpr int width  = 90;
     static constexpr int height = 20;
 
-    int bgColor = stateBGColors[state];
+    const ModelSnapshot& m = model();
+
+    int bgColor = stateBGColors[m.state];
     if (bgColor != 1) {
         canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
     }
-    centered_text(my_state_string, y + height / 2 + 3, stateFGColors[state], TINY);
+    centered_text(m.state_string, y + height / 2 + 3, stateFGColors[m.state], TINY);
 }
 
 void drawStatusSmall(int y) {
     static constexpr int width  = 90;
     static constexpr int height = 25;
 
-    int bgColor = stateBGColors[state];
+    const ModelSnapshot& m = model();
+
+    int bgColor = stateBGColors[m.state];
     if (bgColor != 1) {
         canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
     }
-    centered_text(my_state_string, y + height / 2 + 3, stateFGColors[state], SMALL);
+    centered_text(m.state_string, y + height / 2 + 3, stateFGColors[m.state], SMALL);
 }
 
 Stripe::Stripe(int x, int y, int width, int height, fontnum_t font) : _x(x), _y(y), _width(width), _height(height), _font(font) {}
@@ -184,22 +287,121 @@ static int side_button_line() {
 
 // This shows on the display what the button currently do.
 void drawButtonLegends(const char* red, const char* green, const char* orange) {
-    text(red, round_display ? 50 : 10, side_button_line(), RED, TINY, middle_left);
-    text(green, display_short_side() - (round_display ? 50 : 10), side_button_line(), GREEN, TINY, middle_right);
-    centered_text(orange, DIAL_BUTTON_LINE, ORANGE);
+    label(red, round_display ? 50 : 10, side_button_line(), RED, TINY, middle_left);
+    label(green, display_short_side() - (round_display ? 50 : 10), side_button_line(), GREEN, TINY, middle_right);
+    centered_label(orange, DIAL_BUTTON_LINE, ORANGE);
+}
+void buttonLegendRows(int& top, int& bottom) {
+    const int pad = 2;  // As label() allows for overhanging glyphs
+    int       h   = font_height(TINY);
+    top           = std::min(side_button_line(), DIAL_BUTTON_LINE) - h / 2 - pad;
+    bottom        = DIAL_BUTTON_LINE + (h + 1) / 2 + pad;
+}
+
+// The digits, decimal point and minus sign of a font, rasterized once
+// into a 1-bit sprite.  The palette supplies the color when a glyph is
+// blitted, so one sheet serves every color.
+class GlyphAtlas {
+private:
+    static constexpr const char* _glyphs = "0123456789.-";
+    static const int             _n      = 12;
+    static const int             _pad    = 4;  // Room for glyphs that overhang their advance
+
+    fontnum_t   _font;
+    LGFX_Sprite _sheet;
+    int         _widths[_n];
+    int         _cell_w = 0;
+    int         _cell_h = 0;
+    bool        _tried  = false;
+    bool        _ok     = false;
+
+    bool init() {
+        if (_tried) {
+            return _ok;
+        }
+        _tried = true;
+#ifdef PALETTE_CANVAS
+        // Palette to palette pushes copy indices, not colors, so the
+        // sheet could not be recolored
+        return false;
+#endif
+
+        char txt[2] = { '\0', '\0' };
+        for (int i = 0; i < _n; i++) {
+            txt[0]     = _glyphs[i];
+            _widths[i] = text_width(txt, _font);
+            _cell_w    = std::max(_cell_w, _widths[i] + 2 * _pad);
+        }
+        _cell_h = font_height(_font) + 2 * _pad;
+
+        _sheet.setColorDepth(1);
+        if (!_sheet.createSprite(_cell_w * _n, _cell_h)) {
+            return false;
+        }
+        _sheet.createPalette();
+        _sheet.fillSprite(0);
+        for (int i = 0; i < _n; i++) {
+            txt[0] = _glyphs[i];
+            text(&_sheet, txt, i * _cell_w + _pad, _cell_h / 2, 1, _font, middle_left);
+        }
+        _ok = true;
+        return true;
+    }
+
+public:
+    GlyphAtlas(fontnum_t font) : _font(font) {}
+
+    // Draws c as text() would, or returns false if c is not in the atlas
+    bool draw(char c, int x, int y, int color, int datum) {
+        const char* p = strchr(_glyphs, c);
+        if (!c || !p || !init()) {
+            return false;
+        }
+        int i = p - _glyphs;
+        switch (datum) {
+            case middle_left:
+                break;
+            case middle_center:
+                x -= _widths[i] >> 1;
+                break;
+            case middle_right:
+                x -= _widths[i];
+                break;
+            default:
+                return false;
+        }
+        int cell_x = x - _pad;
+        int cell_y = y - _cell_h / 2;
+        _sheet.setPaletteColor(1, (uint16_t)color);  // RGB565, like setTextColor()
+        canvas.setClipRect(cell_x, cell_y, _cell_w, _cell_h);
+        _sheet.pushSprite(&canvas, cell_x - i * _cell_w, cell_y, 0);
+        canvas.clearClipRect();
+        return true;
+    }
+};
+
+static GlyphAtlas number_glyphs(MEDIUM);
+
+static void number_text(const char* txt, int x, int y, int color, int datum) {
+    if (!number_glyphs.draw(txt[0], x, y, color, datum)) {
+        text(txt, x, y, color, MEDIUM, datum);
+    }
 }
 
-void putDigit(int& n, int x, int y, int color) {
-    char txt[2] = { '\0', '\0' };
-    txt[0]      = "0123456789"[n % 10];
-    n /= 10;
-    text(txt, x, y, color, MEDIUM, middle_right);
+static const int number_cell_w = 20;
+
+static void add_cell(NumberCells& cells, char c, int color) {
+    if (cells.count < NumberCells::max_cells) {
+        cells.chars[cells.count]  = c;
+        cells.colors[cells.count] = color;
+        ++cells.count;
+    }
 }
-void fancyNumber(pos_t n, int n_decimals, int hl_digit, int x, int y, int text_color, int hl_text_color) {
-    fontnum_t font     = SMALL;
-    int       n_digits = n_decimals + 1;
-    int       i;
-    bool      isneg = n < 0;
+
+// Lays out n as fancyNumber() shows it, one cell per character
+static void number_cells(NumberCells& cells, pos_t n, int n_decimals, int hl_digit, int text_color, int hl_text_color) {
+    int  i;
+    bool isneg = n < 0;
     if (isneg) {
         n = -n;
     }
@@ -221,41 +423,88 @@ void fancyNumber(pos_t n, int n_decimals, int hl_digit, int x, int y, int text_c
         n *= 10;
     }
 #endif
-    const int char_width = 20;
+    cells.count = 0;
 
     int ni = (int)n;
     for (i = 0; i < n_decimals; i++) {
-        putDigit(ni, x, y, i == hl_digit ? hl_text_color : text_color);
-        x -= char_width;
+        add_cell(cells, '0' + ni % 10, i == hl_digit ? hl_text_color : text_color);
+        ni /= 10;
     }
     if (n_decimals) {
-        text(".", x - 10, y, text_color, MEDIUM, middle_center);
-        x -= char_width;
+        add_cell(cells, '.', text_color);
     }
     do {
-        putDigit(ni, x, y, i++ == hl_digit ? hl_text_color : text_color);
-        x -= char_width;
+        add_cell(cells, '0' + ni % 10, i++ == hl_digit ? hl_text_color : text_color);
+        ni /= 10;
     } while (ni || i <= hl_digit);
     if (isneg) {
-        text("-", x, y, text_color, MEDIUM, middle_right);
+        add_cell(cells, '-', text_color);
+    }
+}
+
+// Draws cell k of a number whose right edge is at x
+static void draw_cell(const NumberCells& cells, int k, int x, int y) {
+    char txt[2] = { cells.chars[k], '\0' };
+    x -= k * number_cell_w;
+    if (txt[0] == '.') {
+        number_text(txt, x - number_cell_w / 2, y, cells.colors[k], middle_center);
+    } else {
+        number_text(txt, x, y, cells.colors[k], middle_right);
+    }
+}
+
+void fancyNumber(pos_t n, int n_decimals, int hl_digit, int x, int y, int text_color, int hl_text_color) {
+    NumberCells cells;
+    number_cells(cells, n, n_decimals, hl_digit, text_color, hl_text_color);
+    for (int k = 0; k < cells.count; k++) {
+        draw_cell(cells, k, x, y);
     }
 }
 
 void DRO::drawHoming(int axis, bool highlight, bool homed) {
-    text(axisNumToCStr(axis), text_left_x(), text_middle_y(), myLimitSwitches[axis] ? GREEN : YELLOW, MEDIUM, middle_left);
-    fancyNumber(myAxes[axis], num_digits(), -1, text_right_x(), text_middle_y(), highlight ? (homed ? GREEN : RED) : DARKGREY, RED);
+    const ModelSnapshot& m = model();
+    text(axisNumToCStr(axis), text_left_x(), text_middle_y(), m.limits[axis] ? GREEN : YELLOW, MEDIUM, middle_left);
+    fancyNumber(dro_position(axis), num_digits(), -1, text_right_x(), text_middle_y(), highlight ? (homed ? GREEN : RED) : DARKGREY, RED);
     advance();
 }
 
 void DRO::draw(int axis, int hl_digit, bool highlight) {
     text(axisNumToCStr(axis), text_left_x(), text_middle_y(), highlight ? GREEN : DARKGREY, MEDIUM, middle_left);
-    fancyNumber(
-        myAxes[axis], num_digits(), hl_digit, text_right_x(), text_middle_y(), highlight ? WHITE : DARKGREY, highlight ? RED : DARKGREY);
+    fancyNumber(dro_position(axis),
+                num_digits(),
+                hl_digit,
+                text_right_x(),
+                text_middle_y(),
+                highlight ? WHITE : DARKGREY,
+                highlight ? RED : DARKGREY);
+    advance();
+}
+
+void DRO::draw(int axis, int hl_digit, bool highlight, NumberCells& shown) {
+    if (shown.count == 0) {
+        text(axisNumToCStr(axis), text_left_x(), text_middle_y(), highlight ? GREEN : DARKGREY, MEDIUM, middle_left);
+    }
+    NumberCells cells;
+    number_cells(cells, dro_position(axis), num_digits(), hl_digit, highlight ? WHITE : DARKGREY, highlight ? RED : DARKGREY);
+
+    // Usually only the last digit or two of a moving axis differ
+    int right = text_right_x();
+    for (int k = 0; k < std::max(cells.count, shown.count); k++) {
+        if (k < cells.count && k < shown.count && cells.chars[k] == shown.chars[k] && cells.colors[k] == shown.colors[k]) {
+            continue;
+        }
+        restoreBackground(right - (k + 1) * number_cell_w, _y, number_cell_w, height());
+        if (k < cells.count) {
+            draw_cell(cells, k, right, text_middle_y());
+        }
+    }
+    shown = cells;
     advance();
 }
 
 void DRO::draw(int axis, bool highlight) {
-    Stripe::draw(axisNumToChar(axis), pos_to_cstr(myAxes[axis], num_digits()), highlight, myLimitSwitches[axis] ? GREEN : WHITE);
+    const ModelSnapshot& m = model();
+    Stripe::draw(axisNumToChar(axis), pos_to_cstr(dro_position(axis), num_digits()), highlight, m.limits[axis] ? GREEN : WHITE);
 }
 
 void LED::draw(bool highlighted) {
@@ -264,20 +513,305 @@ void LED::draw(bool highlighted) {
 }
 
 void drawMenuTitle(const char* name) {
-    centered_text(name, 12);
+    centered_label(name, 12);
+}
+
+int frames_pushed = 0;
+
+// Damage is found by checksumming each row of the canvas in a few
+// column blocks and comparing with the checksums of the last pushed
+// frame.  Scenes draw on the canvas in many ways and usually start
+// from a cleared background, so comparing content finds what changed
+// more reliably than instrumenting every drawing primitive.
+static const int damage_cols = 12;  // 20 pixels on the 240 pixel canvas, one DRO digit
+static const int max_rows    = 240;
+
+static uint32_t pushed_sums[max_rows][damage_cols];
+static bool     full_push_needed = true;
+static Point    pushed_offset;
+
+void invalidateDisplay() {
+    full_push_needed = true;
+}
+
+// Palette depths carry a flag above the bit count
+static int canvas_bits() {
+    return canvas.getColorDepth() & 0xff;
+}
+
+// Returns a bitmask of the column blocks of row y that changed.  Rows
+// are summed in 16-bit words so a 4-bit canvas divides into blocks too.
+static uint16_t damaged_blocks(int y) {
+    const uint16_t* words       = (const uint16_t*)canvas.getBuffer();
+    int             row_words   = canvas.width() * canvas_bits() / 16;
+    int             block_words = row_words / damage_cols;
+    words += y * row_words;
+
+    uint16_t blocks = 0;
+    for (int b = 0; b < damage_cols; b++) {
+        uint32_t sum = y + 1;
+        for (int i = 0; i < block_words; i++) {
+            sum = sum * 31 + *words++;
+        }
+        if (sum != pushed_sums[y][b]) {
+            pushed_sums[y][b] = sum;
+            blocks |= 1 << b;
+        }
+    }
+    return blocks;
+}
+
+struct push_stats_t {
+    int frames;
+    int pixels;
+    int render_ms;
+    int transfer_ms;
+};
+static std::map<const char*, push_stats_t> push_stats;
+
+static int frame_start_ms = 0;
+
+void startFrame() {
+    frame_start_ms = milliseconds();
+}
+
+static void record_push(int pixels, int render_ms, int transfer_ms) {
+    const char*   name  = current_scene ? current_scene->name() : "";
+    push_stats_t& stats = push_stats[name];
+    ++stats.frames;
+    stats.pixels += pixels;
+    stats.render_ms += render_ms;
+    stats.transfer_ms += transfer_ms;
+    if (stats.frames == 100) {
+        int full_kb = stats.frames * canvas.width() * canvas.height() * 2 / 1024;
+        dbg_printf("%s: %d frames, %d of %d KB pushed, render %d ms, transfer %d ms\n",
+                   name,
+                   stats.frames,
+                   stats.pixels * 2 / 1024,
+                   full_kb,
+                   stats.render_ms,
+                   stats.transfer_ms);
+        stats = push_stats_t {};
+    }
+}
+
+#ifdef DMA_TRANSFER
+// The canvas is converted into a second, RGB565 sprite in the byte
+// order of the panel, which streams to the display by DMA while the UI
+// renders the next frame into the canvas.  The panel depth means DMA
+// reads the pixels as they are, with no conversion by the CPU during
+// the transfer.  The buffer is only made if that leaves RAM to spare.
+static const size_t transfer_headroom = 48 * 1024;  // For backgrounds and caches
+
+static LGFX_Sprite transfer_sprite;
+static bool        transfer_tried   = false;
+static bool        transfer_ok      = false;
+static bool        transfer_pending = false;
+static uint16_t    transfer_colors[256];  // swap565 of each canvas pixel value
+
+static bool init_transfer() {
+    if (!transfer_tried) {
+        transfer_tried = true;
+        int    depth   = canvas_bits();
+        size_t bytes   = canvas.width() * canvas.height() * 2;
+        bool   room    = true;
+#    ifdef ARDUINO
+        room = heap_caps_get_largest_free_block(MALLOC_CAP_DMA) >= bytes + transfer_headroom;
+#    endif
+        if (room && (depth == 4 || depth == 8 || depth == 16)) {
+            for (int i = 0; i < 256; i++) {
+#    ifdef PALETTE_CANVAS
+                uint16_t c = themeColor565(i);
+#    else
+                uint16_t c = lgfx::color565((i >> 5) * 255 / 7, ((i >> 2) & 7) * 255 / 7, (i & 3) * 255 / 3);
+#    endif
+                transfer_colors[i] = (c >> 8) | (c << 8);
+            }
+            transfer_sprite.setColorDepth(16);
+            transfer_ok = transfer_sprite.createSprite(canvas.width(), canvas.height()) != nullptr;
+        }
+        if (!transfer_ok) {
+            dbg_println("No DMA transfer buffer, pushing synchronously");
+        }
+    }
+    return transfer_ok;
+}
+
+// Copies the canvas into the transfer buffer at panel depth
+static void fill_transfer() {
+    const uint8_t* src = (const uint8_t*)canvas.getBuffer();
+    uint16_t*      dst = (uint16_t*)transfer_sprite.getBuffer();
+    int            n   = canvas.width() * canvas.height();
+    switch (canvas_bits()) {
+        case 16:
+            memcpy(dst, src, n * 2);
+            break;
+        case 8:
+            for (int i = 0; i < n; i++) {
+                dst[i] = transfer_colors[src[i]];
+            }
+            break;
+        case 4:  // Two pixels a byte, the left one in the high nibble
+            for (int i = 0; i < n; i += 2) {
+                uint8_t b  = *src++;
+                dst[i]     = transfer_colors[b >> 4];
+                dst[i + 1] = transfer_colors[b & 15];
+            }
+            break;
+    }
+}
+
+// Waits until the previous frame has left the transfer buffer
+static void wait_transfer() {
+    if (transfer_pending) {
+        display.waitDMA();
+        display.endWrite();
+        transfer_pending = false;
+    }
+}
+#else
+static bool init_transfer() {
+    return false;
+}
+static void fill_transfer() {}
+static void wait_transfer() {}
+#endif  // DMA_TRANSFER
+
+static void push_rect(int x, int y, int w, int h) {
+    display.setClipRect(sprite_offset.x + x, sprite_offset.y + y, w, h);
+#ifdef DMA_TRANSFER
+    if (transfer_ok) {
+        display.pushImageDMA(sprite_offset.x,
+                             sprite_offset.y,
+                             transfer_sprite.width(),
+                             transfer_sprite.height(),
+                             (const lgfx::swap565_t*)transfer_sprite.getBuffer());
+        return;
+    }
+#endif
+    canvas.pushSprite(sprite_offset.x, sprite_offset.y);
+}
+
+// On a round display about a fifth of the canvas is outside the visible
+// circle.  Regions are pushed in bands of rows, each clipped to the
+// widest visible span in the band.  Eight-row bands push 81% of a full
+// frame in 30 pieces; single rows would push 79% in 240.
+static const int span_band = 8;
+static int16_t   span_left[max_rows];
+static int16_t   span_right[max_rows];
+static bool      spans_made = false;
+
+static void make_spans(int width, int height) {
+    float r = width / 2.0f;
+    for (int y = 0; y < height; y++) {
+        float dy   = y + 0.5f - height / 2.0f;
+        float half = dy * dy < r * r ? sqrtf(r * r - dy * dy) : 0;
+        span_left[y]  = std::max(0, (int)floorf(r - half));
+        span_right[y] = std::min(width, (int)ceilf(r + half));
+    }
+    spans_made = true;
+}
+
+// Pushes a region of the canvas and returns the number of pixels pushed
+static int push_region(int x, int y, int w, int h) {
+    if (!round_display || canvas.height() > max_rows) {
+        push_rect(x, y, w, h);
+        return w * h;
+    }
+    if (!spans_made) {
+        make_spans(canvas.width(), canvas.height());
+    }
+    int pixels = 0;
+    for (int top = y; top < y + h; top += span_band) {
+        int bottom = std::min(top + span_band, y + h);
+        int left   = x + w;
+        int right  = x;
+        for (int row = top; row < bottom; row++) {
+            left  = std::min<int>(left, span_left[row]);
+            right = std::max<int>(right, span_right[row]);
+        }
+        left  = std::max(left, x);
+        right = std::min(right, x + w);
+        if (right > left) {
+            push_rect(left, top, right - left, bottom - top);
+            pixels += (right - left) * (bottom - top);
+        }
+    }
+    return pixels;
 }
 
 void refreshDisplay() {
+    ++frames_pushed;
+    if (current_scene) {
+        current_scene->rendered();
+    }
+    int start_ms  = milliseconds();
+    int render_ms = start_ms - frame_start_ms;
+
+    wait_transfer();
+
+    int  width       = canvas.width();
+    int  height      = canvas.height();
+    bool trackable   = height <= max_rows && (width * canvas_bits()) % (16 * damage_cols) == 0;
+    bool full        = full_push_needed || !trackable || pushed_offset.x != sprite_offset.x || pushed_offset.y != sprite_offset.y;
+    int  pixels      = 0;
+    full_push_needed = false;
+    pushed_offset    = sprite_offset;
+
+    if (init_transfer()) {
+        fill_transfer();
+    }
+
     display.startWrite();
-    canvas.pushSprite(sprite_offset.x, sprite_offset.y);
+    if (full) {
+        if (trackable) {
+            for (int y = 0; y < height; y++) {
+                damaged_blocks(y);  // Record the checksums
+            }
+        }
+        pixels = push_region(0, 0, width, height);
+    } else {
+        // Merge runs of damaged rows into one rectangle spanning their blocks
+        int      block_w = width / damage_cols;
+        int      top     = -1;
+        uint16_t blocks  = 0;
+        for (int y = 0; y <= height; y++) {
+            uint16_t row_blocks = y < height ? damaged_blocks(y) : 0;
+            if (row_blocks) {
+                if (top < 0) {
+                    top = y;
+                }
+                blocks |= row_blocks;
+            } else if (top >= 0) {
+                int left  = __builtin_ctz(blocks);
+                int right = 32 - __builtin_clz(blocks);
+                pixels += push_region(left * block_w, top, (right - left) * block_w, y - top);
+                top    = -1;
+                blocks = 0;
+            }
+        }
+    }
+    display.clearClipRect();
+#ifdef DMA_TRANSFER
+    if (transfer_ok) {
+        transfer_pending = true;  // Ended by the next wait_transfer()
+    } else {
+        display.endWrite();
+    }
+#else
     display.endWrite();
+#endif
+
+    // With DMA this is the time to queue the transfer plus any wait for
+    // the previous one; the rest overlaps the next render
+    record_push(pixels, render_ms, milliseconds() - start_ms);
 }
 
 void drawError() {
     if (lastError) {
         if ((milliseconds() - errorExpire) < 0) {
             canvas.fillCircle(120, 120, 95, RED);
-            drawCircle(120, 120, 95, 5, WHITE);
+            drawRing(120, 120, 95, 91, WHITE);
             centered_text("Error", 95, WHITE, MEDIUM);
             centered_text(decode_error_number(lastError), 140, WHITE, TINY);
         } else {
@@ -285,3 +819,25 @@ void drawError() {
         }
     }
 }
+
+void ScrollOffset::add(int delta, int limit) {
+    if (_value == 0) {
+        _last_ms = milliseconds();
+    }
+    _value = std::max(-limit, std::min(limit, _value + delta));
+}
+bool ScrollOffset::step() {
+    int now   = milliseconds();
+    int steps = (now - _last_ms) / UPDATE_RATE_MS;
+    _last_ms += steps * UPDATE_RATE_MS;
+    while (steps-- && _value) {
+        _value /= 2;  // Rounds toward zero, so it always gets there
+    }
+    if (abs(_value) < 2) {
+        _value = 0;
+    }
+    return _value != 0;
+}
+int ScrollOffset::next_step_ms() {
+    return std::max(0, _last_ms + UPDATE_RATE_MS - milliseconds());
+}
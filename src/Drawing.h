@@ -30,6 +30,7 @@ public:
     void draw(char left, const char* right, bool highlighted, int left_color = WHITE);
     void draw(const char* center, bool highlighted);
     int  y() { return _y; }
+    int  height() { return _height; }
     int  gap() { return _height + 1; }
     void advance() { _y += gap(); }
 };
@@ -45,22 +46,64 @@ public:
     void draw(bool highlighted);
 };
 
+// The characters of a number drawn by fancyNumber() and their colors,
+// one per fixed-width cell counting from the right
+struct NumberCells {
+    static const int max_cells = 16;
+    int              count     = 0;  // 0 when nothing has been drawn
+    char             chars[max_cells];
+    int              colors[max_cells];
+};
+
 class DRO : public Stripe {
 public:
     DRO(int x, int y, int width, int height) : Stripe(x, y, width, height, MEDIUM_MONO) {}
     void draw(int axis, bool highlight);
     void draw(int axis, int hl_digit, bool highlight);
+    // Like draw(axis, hl_digit, highlight), but repaints only the cells
+    // that differ from shown, over the scene background, and updates
+    // shown.  The axis label is drawn only when shown is empty.
+    void draw(int axis, int hl_digit, bool highlight, NumberCells& shown);
     void drawHoming(int axis, bool highlight, bool homed);
 };
 
+// The pixel distance a scrolled list still has to travel to its resting
+// place.  It halves every UPDATE_RATE_MS, so an animation eases out;
+// frames that a busy loop misses are skipped, not queued.
+class ScrollOffset {
+private:
+    int _value   = 0;
+    int _last_ms = 0;
+
+public:
+    // Adds a scroll of delta pixels, keeping the lag within +-limit
+    void add(int delta, int limit);
+    // Advances the animation to now; true while still moving
+    bool step();
+    // Milliseconds until step() next changes the value
+    int  next_step_ms();
+    int  value() { return _value; }
+    void stop() { _value = 0; }
+};
+
 // draw stuff
 // Routines that take Point as an argument work in a coordinate
 // space where 0,0 is at the center of the display and +Y is up
 
 LGFX_Sprite* createPngBackground(const char* filename);
 
+// With PALETTE_CANVAS, gives sprite the theme palette; otherwise does nothing
+void useThemePalette(LGFX_Sprite* sprite);
+// The RGB565 value of a color, for drawing outside the canvas
+int themeColor565(int color);
+// The color value, as drawing functions take it, nearest to an RGB332 pixel
+int themeColor332(uint8_t rgb332);
+
 void drawBackground(LGFX_Sprite* sprite);
 void drawBackground(int color);
+// Redraws the scene background, as system_background() draws it, in
+// a rectangle of the canvas
+void restoreBackground(int x, int y, int w, int h);
 void drawStatus();
 void drawStatusTiny(int y);
 void drawStatusSmall(int y);
@@ -68,6 +111,12 @@ void drawStatusSmall(int y);
 void drawFilledCircle(int x, int y, int radius, int fillcolor);
 void drawFilledCircle(Point xy, int radius, int fillcolor);
 
+// Filled annulus of the pixels from inner to outer radius
+void drawRing(int x, int y, int outer, int inner, int color);
+// The part of a ring from start_angle clockwise to end_angle, in degrees
+// clockwise from 3 o'clock like LovyanGFX's arcs
+void drawThickArc(int x, int y, int outer, int inner, int start_angle, int end_angle, int color);
+
 void drawCircle(int x, int y, int radius, int thickness, int outlinecolor);
 void drawCircle(Point xy, int radius, int thickness, int outlinecolor);
 
@@ -82,12 +131,22 @@ void drawOutlinedRect(int x, int y, int width, int height, int bgcolor, int outl
 void drawOutlinedRect(Point xy, int width, int height, int bgcolor, int outlinecolor);
 
 void drawButtonLegends(const char* red, const char* green, const char* orange);
+// The rows from top up to bottom that drawButtonLegends() can draw on
+void buttonLegendRows(int& top, int& bottom);
 void drawMenuTitle(const char* name);
 
 void drawPngFile(const char* filename, Point xy);
 void drawPngBackground(const char* filename);
 
+// Pushes the parts of the canvas that changed since the last push
 void refreshDisplay();
+// Makes the next refreshDisplay() push the whole canvas, e.g. after
+// something else drew on the display
+void invalidateDisplay();
+// Marks the start of rendering a frame, for refreshDisplay() statistics
+void startFrame();
+
+extern int frames_pushed;  // Number of refreshDisplay() calls
 
 void drawError();
 
@@ -58,7 +58,7 @@ void FileMenu::onEntry(void* arg) {
 }
 
 void FileMenu::onRedButtonPress() {
-    if (state != Idle) {
+    if (model().state != Idle) {
         return;
     }
     if (dirLevel) {
@@ -78,7 +78,7 @@ void FileMenu::onDialButtonPress() {
 }
 
 void FileMenu::onGreenButtonPress() {
-    if (state != Idle) {
+    if (model().state != Idle) {
         return;
     }
     if (num_items()) {
@@ -123,7 +123,7 @@ void FileMenu::buttonLegends() {
     const char* grnLabel = "";
     const char* redLabel = "";
 
-    if (state == Idle) {
+    if (model().state == Idle) {
         redLabel = dirLevel ? "Up.." : "Refresh";
 
         if (num_items()) {
@@ -152,7 +152,7 @@ void FileMenu::rotate(int delta) {
         _selected = num_items() - 1;
     }
     _items[_selected]->highlight();
-    reDisplay();
+    invalidate();
 }
 
 int FileMenu::touchedItem(int x, int y) {
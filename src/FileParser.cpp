@@ -3,7 +3,7 @@
 
 #include "FileParser.h"
 
-#include "Scene.h"  // current_scene->reDisplay()
+#include "Scene.h"  // post_event()
 #include "Menu.h"
 #include "GrblParserC.h"  // send_line()
 #include "HomingScene.h"  // set_axis_homed()
@@ -82,7 +82,7 @@ public:
 
     void endArray() override {
         std::sort(fileVector.begin(), fileVector.end(), fileinfoCompare);
-        current_scene->onFilesList();
+        post_event(FilesListEvent);
         parser.setListener(pInitialListener);
     }
 
@@ -161,7 +161,7 @@ public:
     }
 
     void endDocument() override {
-        current_scene->onFilesList();
+        post_event(FilesListEvent);
         init_listener();
     }
 } macroLinesListener;
@@ -212,7 +212,7 @@ public:
 
     void endArray() override {
         // Otherwise this is the end
-        current_scene->onFilesList();
+        post_event(FilesListEvent);
         parser.setListener(pInitialListener);
     }
     void endObject() override {
@@ -256,7 +256,7 @@ public:
     void endArray() override {
         if (_in_macros_section) {
             _in_macros_section = false;
-            current_scene->onFilesList();
+            post_event(FilesListEvent);
         }
     }
 
@@ -344,7 +344,7 @@ void try_next_macro_file(JsonListener* listener) {
         return;
     }
     if (listener == &preferencesListener) {
-        current_scene->onError("No Macros");
+        post_error("No Macros");
         return;
     }
     if (listener == &macrocfgListener) {
@@ -489,7 +489,7 @@ public:
                 _status = value;
                 break;
             case ERROR:
-                current_scene->onError(value);
+                post_error(value);
                 break;
         }
         _key = NONE;
@@ -625,7 +625,7 @@ void handle_radio_mode(char* command, char* arguments) {
     wifi_mode = value;
     if (strcmp(value, "No Wifi") != 0) {
         parse_wifi(arguments);
-        current_scene->reDisplay();
+        post_event(ModelChangedEvent);
     }
 }
 
@@ -642,7 +642,7 @@ extern "C" void handle_msg(char* command, char* arguments) {
     }
     if (strcmp(command, "RST") == 0) {
         dbg_println("FluidNC Reset");
-        state = Disconnected;
+        set_disconnected_state();
         act_on_state_change();
     }
     if (strcmp(command, "Files changed") == 0) {
@@ -106,7 +106,7 @@ public:
     //#define DEBUG_FILE_LIST
     void endDocument() override {
         init_listener();
-        current_scene->onFilesList();
+        post_event(FilesListEvent);
     }
 } filesListListener;
 #endif
@@ -5,20 +5,137 @@
 #include "Scene.h"
 #include "FileParser.h"
 #include <map>
+#include <cctype>
 
 extern Scene menuScene;
 extern Scene statusScene;
 
+// A preview line is split into colored spans once, when it arrives,
+// and rendered once into a sprite.  Redraws - which happen on every
+// status report - then only have to blit the sprite.
+struct span_t {
+    size_t start;
+    size_t len;
+    int    color;
+};
+
+static int word_color(char letter) {
+    switch (toupper(letter)) {
+        case 'G':
+        case 'M':
+            return CYAN;
+        case 'F':
+        case 'S':
+            return YELLOW;
+        case 'T':
+            return ORANGE;
+        case 'N':
+            return DARKGREY;
+        default:  // Coordinates and other parameters
+            return WHITE;
+    }
+}
+
+static void tokenize_gcode(const std::string& line, std::vector<span_t>& spans) {
+    size_t len = line.length();
+    size_t i   = 0;
+    while (i < len) {
+        size_t start = i;
+        char   c     = line[i];
+        int    color = LIGHTGREY;
+        if (c == '(') {
+            size_t end = line.find(')', i);
+            i          = end == std::string::npos ? len : end + 1;
+            color      = DARKGREY;
+        } else if (c == ';') {
+            i     = len;
+            color = DARKGREY;
+        } else if (isalpha(c)) {
+            // A word is a letter followed by a number, possibly with spaces between
+            color = word_color(c);
+            ++i;
+            while (i < len && (isdigit(line[i]) || strchr(" .+-", line[i]))) {
+                ++i;
+            }
+        } else {
+            ++i;
+            while (i < len && !isalpha(line[i]) && line[i] != '(' && line[i] != ';') {
+                ++i;
+            }
+        }
+        spans.push_back({ start, i - start, color });
+    }
+}
+
+class PreviewLine {
+private:
+    std::string         _text;
+    std::vector<span_t> _spans;
+    LGFX_Sprite*        _sprite = nullptr;
+
+    void draw_spans(LGFX_Sprite* sprite, int x, int y) {
+        for (auto const& span : _spans) {
+            std::string s = _text.substr(span.start, span.len);
+            text(sprite, s.c_str(), x, y, span.color, TINY, top_left);
+            x += text_width(s.c_str(), TINY);
+        }
+    }
+
+public:
+    PreviewLine(const std::string& line) : _text(line) { tokenize_gcode(_text, _spans); }
+    ~PreviewLine() { release(); }
+
+    // The sprite is owned, so a copy would free it twice
+    PreviewLine(const PreviewLine&)            = delete;
+    PreviewLine& operator=(const PreviewLine&) = delete;
+
+    // Frees the rendered sprite; it will be re-created on the next draw
+    void release() {
+        if (_sprite) {
+            delete _sprite;
+            _sprite = nullptr;
+        }
+    }
+
+    const std::string& text_str() { return _text; }
+
+    void draw(int x, int y) {
+        if (!_sprite) {
+            _sprite = new LGFX_Sprite(&canvas);
+            _sprite->setColorDepth(canvas.getColorDepth());
+            // Lines run to the right edge of the canvas, as they did when
+            // they were drawn directly
+            if (!_sprite->createSprite(canvas.width() - x, font_height(TINY))) {
+                // Not enough memory for the cache; draw directly
+                delete _sprite;
+                _sprite = nullptr;
+                draw_spans(&canvas, x, y);
+                return;
+            }
+            _sprite->fillSprite(BLACK);
+            draw_spans(_sprite, 0, 0);
+        }
+        _sprite->pushSprite(&canvas, x, y, BLACK);
+    }
+};
+
 class FilePreviewScene : public Scene {
     std::string _error_string;
     std::string _filename;
     bool        _needlines;
     int         _firstline = 0;
 
-    std::map<int, std::string> _lines;
+    std::map<int, PreviewLine*> _lines;
 
     static const int _nlines = 7;
 
+    void clear_lines() {
+        for (auto const& entry : _lines) {
+            delete entry.second;
+        }
+        _lines.clear();
+    }
+
 public:
     FilePreviewScene() : Scene("Preview", 4) {}
     void get_lines() {
@@ -35,13 +152,30 @@ public:
             _needlines = false;
         }
     }
+    void onExit() override {
+        // Give the sprite memory back while other scenes are active
+        for (auto const& entry : _lines) {
+            entry.second->release();
+        }
+    }
     void onFileLines(int firstline, const std::vector<std::string>& lines) {
         _error_string.clear();
         _needlines = false;
-        _lines.clear();
+
+        // Keep the already-rendered lines that are still visible after a scroll
+        std::map<int, PreviewLine*> new_lines;
         for (auto const& line : lines) {
-            _lines[firstline++] = line;
+            auto found = _lines.find(firstline);
+            if (found != _lines.end() && found->second->text_str() == line) {
+                new_lines[firstline] = found->second;
+                _lines.erase(found);
+            } else {
+                new_lines[firstline] = new PreviewLine(line);
+            }
+            ++firstline;
         }
+        clear_lines();
+        _lines = new_lines;
         reDisplay();
     }
     void onError(const char* errstr) {
@@ -65,23 +199,27 @@ public:
     void onEncoder(int delta) override { scroll(delta); }
 
     void onRedButtonPress() {
-        if (state == Idle) {
+        if (model().state == Idle) {
             pop_scene();
             ackBeep();
         }
     }
 
-    void onDROChange() { reDisplay(); }
+    void onDROChange(change_mask_t changes) override {
+        if (changes & StateNameChanged) {  // Only the status pill depends on the model
+            invalidate();
+        }
+    }
 
     void onGreenButtonPress() {
-        if (state == Idle) {
+        if (model().state == Idle) {
             send_linef("$SD/Run=%s", _filename.c_str());
             ackBeep();
         }
     }
 
     void onStateChange(state_t old_state) {
-        if (state == Cycle) {
+        if (model().state == Cycle) {
             push_scene(&statusScene);
         }
     }
@@ -93,13 +231,13 @@ public:
         const char* grnLabel = "";
         const char* redLabel = "";
 
-        if (state == Idle) {
+        if (model().state == Idle) {
             if (_needlines == false) {
                 int y  = 48;
                 int tl = 0;
                 if (_lines.size()) {
                     for (auto const& entry : _lines) {
-                        text(entry.second.c_str(), 25, y + tl * 22, WHITE, TINY, top_left);
+                        entry.second->draw(25, y + tl * 22);
                         ++tl;
                     }
                 } else {
@@ -6,7 +6,6 @@
 #include "FileParser.h"
 #include "polar.h"
 
-// #define SMOOTH_SCROLL
 #define WRAP_FILE_LIST
 
 extern Scene filePreviewScene;
@@ -51,7 +50,7 @@ public:
     void onDialButtonPress() { pop_scene(); }
 
     void onGreenButtonPress() {
-        if (state != Idle) {
+        if (model().state != Idle) {
             return;
         }
         if (fileVector.size()) {
@@ -74,7 +73,7 @@ public:
     }
 
     void onRedButtonPress() {
-        if (state != Idle) {
+        if (model().state != Idle) {
             return;
         }
         if (dirLevel) {
@@ -100,6 +99,10 @@ public:
     }
     void onFilesList() override {
         _selected_file = prevSelect.back();
+#ifdef SMOOTH_SCROLL
+        _scroll.stop();
+        forgetStrip();
+#endif
         reDisplay();
     }
 
@@ -114,7 +117,7 @@ public:
         const char* grnLabel = "";
         const char* redLabel = "";
 
-        if (state == Idle) {
+        if (model().state == Idle) {
             redLabel = dirLevel ? "Up.." : "Refresh";
             if (fileVector.size()) {
                 grnLabel = fileVector[_selected_file].isDir() ? "Down.." : "Load";
@@ -169,7 +172,124 @@ public:
 
     void onRightFlick() { activate_scene(&jogScene); }
 
+    // Space for a small filename y_offset from the middle
+    int row_width(int y_offset) {
+        int width = big_width;
+        if (round_display) {
+            // If the display is round, we need to reduce the width available
+            // for filename display when we are off-center.
+            // This is a one-term approximation for
+            //   delta_width = 2 * half_width * (1 - cos(arcsin(y_offset/half_width)))
+            // The first term of arcsin(x) is x and the first term of cos(x) is 1-x*x/2
+            // so 2*h*(1 - cos(arcsin(y/h))
+            // ~= 2*h**(1 - (1 - y*y/2*h*h))
+            // = 2*h*(y*y/2*h*h)
+            // = y*y/h
+            int half_width  = width / 2;
+            int delta_width = y_offset * y_offset / half_width;
+            width -= delta_width;
+        }
+        return width;
+    }
+
+#ifdef SMOOTH_SCROLL
+    // While a scroll animates, the filenames slide by in the small font.
+    // Each one is rendered once into a row of _strip, which is used as a
+    // ring indexed by _scroll_index, and pushed at its offset every frame.
+    static const int strip_rows = 5;  // The three shown plus one entering at each end
+
+    LGFX_Sprite  _strip { &canvas };
+    int          _strip_row_h = 0;
+    int          _strip_file[strip_rows];  // File in each row, or -1
+    int          _scroll_index = 0;        // _selected_file without wrapping
+    ScrollOffset _scroll;
+
+    int row_pitch() { return y_inc + y_distance; }
+
+    void forgetStrip() {
+        for (int i = 0; i < strip_rows; i++) {
+            _strip_file[i] = -1;
+        }
+    }
+
+    // The file r rows below the selected one, or -1 if there is none
+    int file_at(int r) {
+        int n = fileVector.size();
+        int f = _selected_file + r;
+#ifdef WRAP_FILE_LIST
+        if (n > 2) {
+            f = (f % n + n) % n;
+        }
+#endif
+        return (f >= 0 && f < n) ? f : -1;
+    }
+
+    void drawStripRow(int r, int y_offset) {
+        int file = file_at(r);
+        if (file < 0) {
+            return;
+        }
+        int slot = ((_scroll_index + r) % strip_rows + strip_rows) % strip_rows;
+        int top  = slot * _strip_row_h;
+        if (_strip_file[slot] != file) {
+            _strip.fillRect(0, top, big_width, _strip_row_h, BLACK);
+            auto_text(&_strip,
+                      fileVector[file].fileName,
+                      big_width / 2,
+                      top + _strip_row_h / 2,
+                      row_width(row_pitch()),
+                      WHITE,
+                      SMALL,
+                      middle_center);
+            _strip_file[slot] = file;
+        }
+        Point xy   = Point(x_offset, y_offset).to_display();
+        int   left = xy.x - big_width / 2;
+        int   dest = xy.y - _strip_row_h / 2;
+        canvas.setClipRect(left, dest, big_width, _strip_row_h);
+        _strip.pushSprite(&canvas, left, dest - top, BLACK);
+        canvas.clearClipRect();
+    }
+
+    // Draws one animation frame, or returns false if there is no memory
+    // for the strip
+    bool showMovingFiles() {
+        if (!_strip.getBuffer()) {
+            _strip_row_h = font_height(SMALL) + 4;
+            _strip.setColorDepth(canvas.getColorDepth());
+            if (!_strip.createSprite(big_width, strip_rows * _strip_row_h)) {
+                return false;
+            }
+            useThemePalette(&_strip);
+            forgetStrip();
+        }
+        background();
+        for (int r = -2; r <= 2; r++) {
+            drawStripRow(r, _scroll.value() - r * row_pitch());
+        }
+        drawMenuTitle(current_scene->name());
+        buttonLegends();
+        drawStatusSmall(21);
+        refreshDisplay();
+        return true;
+    }
+
+    void onExit() override {
+        _scroll.stop();
+        _strip.deleteSprite();
+    }
+#endif
+
     void showFiles() {
+#ifdef SMOOTH_SCROLL
+        if (_scroll.step()) {
+            if (showMovingFiles()) {
+                invalidateAfter(_scroll.next_step_ms());  // When the offset next changes
+                return;
+            }
+            _scroll.stop();
+        }
+#endif
         // canvas.createSprite(240, 240);
         // drawBackground(BLACK);
         background();
@@ -231,9 +351,7 @@ public:
                     int width  = 8;
                     int radius = width / 2;
                     if (round_display) {
-                        for (int i = 0; i < width; i++) {
-                            canvas.drawArc(120, 120, 119 - i, 115 - i, -50, 50, DARKGREY);
-                        }
+                        drawThickArc(120, 120, 119, 120 - width - 4, -50, 50, DARKGREY);
 
                         int x, y;
                         int arc_degrees = 100;
@@ -272,21 +390,7 @@ public:
                 int y_offset = offset * y_inc;
                 y_offset += (offset > 0) ? y_distance : -y_distance;
                 printf("y_offset %d\n", y_offset);
-                int width = big_width;
-                if (round_display) {
-                    // If the display is round, we need to reduce the width available
-                    // for filename display when we are off-center.
-                    // This is a one-term approximation for
-                    //   delta_width = 2 * half_width * (1 - cos(arcsin(y_offset/half_width)))
-                    // The first term of arcsin(x) is x and the first term of cos(x) is 1-x*x/2
-                    // so 2*h*(1 - cos(arcsin(y/h))
-                    // ~= 2*h**(1 - (1 - y*y/2*h*h))
-                    // = 2*h*(y*y/2*h*h)
-                    // = y*y/h
-                    int half_width  = width / 2;
-                    int delta_width = y_offset * y_offset / half_width;
-                    width -= delta_width;
-                }
+                int width = row_width(y_offset);
                 auto_text(fName, Point(x_offset, y_offset), width, WHITE, SMALL, middle_center);
             }
         }  // for(display_slot)
@@ -316,7 +420,14 @@ public:
 #endif
 
         _selected_file = nextSelect;
-        showFiles();
+#ifdef SMOOTH_SCROLL
+        // The new selection slides in from where it was.  The lag is
+        // limited to one row, so fast spins jump ahead instead of
+        // queueing a long animation.
+        _scroll_index += updown;
+        _scroll.add(-updown * row_pitch(), row_pitch());
+#endif
+        invalidate();
     }
 
     void reDisplay() {
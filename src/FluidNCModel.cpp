@@ -5,28 +5,53 @@
 #include "ConfigItem.h"
 #include "FileParser.h"  // init_file_list()
 #include <map>
+#include <atomic>
 #include "System.h"
 #include "Scene.h"
 #include "e4math.h"
 #include "HomingScene.h"
+#include "PositionHistory.h"
+#include <math.h>
 
 extern Scene statusScene;
 
 // local copies of status items
-const char*        my_state_string    = "N/C";
-state_t            state              = Idle;
-int                n_axes             = 3;
-pos_t              myAxes[6]          = { 0 };
-bool               myLimitSwitches[6] = { false };
-bool               myProbeSwitch      = false;
-const char*        myFile             = "";  // running SD filename
-const char*        myCtrlPins         = "";
-file_percent_t     myPercent          = 0.0;  // percent conplete of SD file
-override_percent_t myFro              = 100;  // Feed rate override
-override_percent_t mySro              = 100;  // Spindle Override
-uint32_t           myFeed             = 0;
-uint32_t           mySpeed            = 0;
-uint32_t           mySelectedTool     = 0;
+const char* myFile         = "";  // running SD filename
+uint32_t    mySelectedTool = 0;
+
+// Three buffers, so the parser and a renderer on another task never
+// share one.  The parser fills the back buffer piecemeal while a status
+// report is being parsed, and end_status_report() publishes it by
+// exchanging it with the shared middle one.  The renderer swaps the
+// middle one into its front buffer only in latch_model(), so everything
+// it reads between latches comes from one complete report.  The back
+// buffer is refreshed from the last published one when the next report
+// begins, because reports do not always contain every field.
+static const uint8_t        fresh_snapshot = 4;  // Flag in middle_snapshot
+static ModelSnapshot        snapshots[3];
+static ModelSnapshot*       back_snapshot  = &snapshots[0];
+static const ModelSnapshot* last_published = &snapshots[1];  // Only the parser reads this
+static int                  front_index    = 1;
+static std::atomic<uint8_t> middle_snapshot(2);
+static uint32_t             snapshot_seq = 0;
+
+const ModelSnapshot& model() {
+    return snapshots[front_index];
+}
+
+void latch_model() {
+    if (middle_snapshot.load(std::memory_order_relaxed) & fresh_snapshot) {
+        front_index = middle_snapshot.exchange(front_index, std::memory_order_acq_rel) & 3;
+    }
+}
+
+static void publish_snapshot() {
+    back_snapshot->seq = ++snapshot_seq;
+    last_published     = back_snapshot;
+
+    int old       = middle_snapshot.exchange((back_snapshot - snapshots) | fresh_snapshot, std::memory_order_acq_rel) & 3;
+    back_snapshot = &snapshots[old];
+}
 
 std::string myModes = "no data";
 
@@ -39,44 +64,109 @@ int num_digits() {
     return inInches ? 3 : 2;
 }
 
-// clang-format off
-// Maps the state strings in status reports to internal state enum values
-struct cmp_str {
-   bool operator()(char const *a, char const *b) const    {
-      return strcmp(a, b) < 0;
-   }
-};
+static PositionHistory position_history;
 
-std::map<const char *, state_t, cmp_str>  state_map = {
-    { "Idle", Idle },
-    { "Alarm", Alarm },
-    { "Hold:0", Hold },
-    { "Hold:1", Hold },
-    { "Run", Cycle },
-    { "Jog", Jog },
-    { "Home", Homing },
-    { "Door:0", DoorClosed },
-    { "Door:1", DoorOpen },
-    { "Check", CheckMode },
-    { "Sleep", GrblSleep },
-};
-// clang-format on
+pos_t dro_position(int axis) {
+#ifdef INTERPOLATE_DRO
+    int now = milliseconds();
+    if (position_history.moving(now)) {
+        return position_history.extrapolate(axis, now);
+    }
+#endif
+    return model().axes[axis];
+}
 
-bool decode_state_string(const char* state_string, state_t& state) {
-    if (strcmp(my_state_string, state_string) != 0) {
-        auto found = state_map.find(state_string);
-        if (found != state_map.end()) {
-            my_state_string = found->first;
-            state           = found->second;
-            return true;
-        }
+bool dro_interpolation_due() {
+#ifdef INTERPOLATE_DRO
+    static int next_ms = 0;
+    int        now     = milliseconds();
+    if (position_history.moving(now) && (now - next_ms) >= 0) {
+        next_ms = now + UPDATE_RATE_MS;
+        return true;
     }
+#endif
     return false;
 }
 
+// Logs when the feed measured from the DRO history disagrees with the
+// feed that FluidNC reports, which can indicate lost or stale reports
+static void check_feed(uint32_t reported) {
+    static bool mismatched = false;
+
+    float actual = position_history.path_feed();
+    if (inInches) {
+        actual *= 25.4f;  // The history is in display units, reports in mm/min
+    }
+    bool mismatch = last_published->state == Cycle && reported > 0 && fabsf(actual - reported) > reported / 4;
+    if (mismatch != mismatched) {
+        mismatched = mismatch;
+        if (mismatch) {
+            dbg_printf("Measured feed %d differs from reported %d\n", (int)actual, (int)reported);
+        }
+    }
+}
+
+// Maps the state strings in status reports to internal state enum values.
+// The decoder switches on a key made from the length and the first and
+// last characters, which is unique for every FluidNC state name.  The
+// keys are computed at compile time, so a collision between two names
+// is a compile error (duplicate case value), and decoding needs no heap
+// and only one string compare to confirm the match.
+constexpr uint32_t state_key(const char* s, size_t len) {
+    return ((uint32_t)len << 16) | ((uint32_t)(uint8_t)s[0] << 8) | (uint8_t)s[len - 1];
+}
+template <size_t N>
+constexpr uint32_t state_key(const char (&s)[N]) {
+    return state_key(s, N - 1);
+}
+
+#define DECODE_STATE(str, st)                                                                                                              \
+    case state_key(str):                                                                                                                   \
+        name      = str;                                                                                                                   \
+        new_state = st;                                                                                                                    \
+        break
+
+bool decode_state_string(const char* state_string, state_t& state, const char*& state_name) {
+    size_t len = strlen(state_string);
+    if (len == 0) {
+        return false;
+    }
+    const char* name;
+    state_t     new_state;
+    switch (state_key(state_string, len)) {
+        DECODE_STATE("Idle", Idle);
+        DECODE_STATE("Alarm", Alarm);
+        DECODE_STATE("Hold:0", Hold);
+        DECODE_STATE("Hold:1", Hold);
+        DECODE_STATE("Run", Cycle);
+        DECODE_STATE("Jog", Jog);
+        DECODE_STATE("Home", Homing);
+        DECODE_STATE("Door:0", DoorClosed);  // Ready to resume
+        DECODE_STATE("Door:1", DoorOpen);    // Stopped, door still ajar
+        DECODE_STATE("Door:2", DoorOpen);    // Door opened, retracting
+        DECODE_STATE("Door:3", DoorClosed);  // Door closed, restoring
+        DECODE_STATE("Check", CheckMode);
+        DECODE_STATE("Sleep", GrblSleep);
+        default:
+            return false;
+    }
+    if (strcmp(state_string, name) != 0) {
+        return false;
+    }
+    state      = new_state;
+    state_name = name;
+    return true;
+}
+#undef DECODE_STATE
+
 void set_disconnected_state() {
-    state           = Disconnected;
-    my_state_string = "N/C";
+    // There will be no status report to publish this
+    *back_snapshot              = *last_published;
+    back_snapshot->state        = Disconnected;
+    back_snapshot->state_string = "N/C";
+    publish_snapshot();
+    latch_model();  // The caller is on the UI task and acts on it at once
+    position_history.clear();
 }
 
 // clang-format off
@@ -107,44 +197,83 @@ const char* decode_error_number(int error_num) {
     return retval;
 }
 
+// Statistics on how many status reports caused a redraw
+static int frames_rendered = 0;
+static int frames_skipped  = 0;
+
+// Returns the fields that differ between two snapshots
+static change_mask_t snapshot_changes(const ModelSnapshot& old, const ModelSnapshot& now) {
+    change_mask_t changes = 0;
+    for (int axis = 0; axis < 6; axis++) {
+        if (old.axes[axis] != now.axes[axis]) {
+            changes |= axis_changed(axis);
+        }
+    }
+    if (old.fro != now.fro || old.sro != now.sro) {
+        changes |= OverridesChanged;
+    }
+    if (old.feed != now.feed || old.speed != now.speed) {
+        changes |= FeedSpeedChanged;
+    }
+    if (strcmp(old.ctrl_pins, now.ctrl_pins) != 0) {
+        changes |= PinsChanged;
+    }
+    if (old.percent != now.percent) {
+        changes |= PercentChanged;
+    }
+    if (memcmp(old.limits, now.limits, sizeof(old.limits)) != 0) {
+        changes |= LimitsChanged;
+    }
+    if (old.probe != now.probe) {
+        changes |= ProbeChanged;
+    }
+    if (old.state_string != now.state_string) {  // Canonical pointers from decode_state_string()
+        changes |= StateNameChanged;
+    }
+    return changes;
+}
+
 extern "C" void begin_status_report() {
-    myPercent = 0;
+    *back_snapshot         = *last_published;
+    back_snapshot->percent = 0;  // The file percentage is absent when no file is running
 }
 
 extern "C" void show_file(const char* filename, file_percent_t percent) {
-    myPercent = percent;
+    back_snapshot->percent = percent;
 }
 
 extern "C" void show_overrides(override_percent_t feed_ovr, override_percent_t rapid_ovr, override_percent_t spindle_ovr) {
-    myFro = feed_ovr;
-    mySro = spindle_ovr;
+    back_snapshot->fro = feed_ovr;
+    back_snapshot->sro = spindle_ovr;
 }
 
 extern "C" void show_feed_spindle(uint32_t feedrate, uint32_t spindle_speed) {
-    myFeed  = feedrate;
-    mySpeed = spindle_speed;
+    back_snapshot->feed  = feedrate;
+    back_snapshot->speed = spindle_speed;
 };
 
 extern "C" void show_limits(bool probe, const bool* limits, size_t n_axis) {
-    myProbeSwitch = probe;
-    memcpy(myLimitSwitches, limits, n_axis * sizeof(*limits));
+    back_snapshot->probe = probe;
+    memcpy(back_snapshot->limits, limits, n_axis * sizeof(*limits));
 }
 
 extern "C" void show_control_pins(const char* pins) {
     //dbg_printf("show_control_pins:%s\r\n", pins);
-    myCtrlPins = pins;
+    // Copy because pins points into the parser's line buffer
+    strncpy(back_snapshot->ctrl_pins, pins, sizeof(back_snapshot->ctrl_pins) - 1);
 }
 
 #ifdef E4_POS_T
 extern "C" void show_dro(const pos_t* axes, const pos_t* wco, bool isMpos, bool* limits, size_t n_axis) {
-    n_axes = (int)n_axis;
+    back_snapshot->n_axes = (int)n_axis;
     for (int axis = 0; axis < n_axis; axis++) {
         e4_t axis_val = axes[axis];
         if (isMpos) {
             axis_val -= wco[axis];
         }
-        myAxes[axis] = inInches ? e4_mm_to_inch(axis_val) : axis_val;
+        back_snapshot->axes[axis] = inInches ? e4_mm_to_inch(axis_val) : axis_val;
     }
+    position_history.record(milliseconds(), back_snapshot->axes, n_axis);
 }
 #else
 pos_t fromMm(pos_t position) {
@@ -156,15 +285,29 @@ pos_t toMm(pos_t position) {
 
 extern "C" void show_dro(const pos_t* axes, const pos_t* wco, bool isMpos, bool* limits, size_t n_axis) {
     for (int axis = 0; axis < n_axis; axis++) {
-        myAxes[axis] = fromMm(axes[axis]);
+        back_snapshot->axes[axis] = fromMm(axes[axis]);
         if (isMpos) {
-            myAxes[axis] -= fromMm(wco[axis]);
+            back_snapshot->axes[axis] -= fromMm(wco[axis]);
         }
     }
+    position_history.record(milliseconds(), back_snapshot->axes, n_axis);
 }
 #endif
 
+// FluidNC answers every line with one ok or error, in order, so counting
+// both tells which line an answer, and the output before it, belongs to
+static uint32_t n_lines_sent  = 0;
+static uint32_t n_lines_acked = 0;
+
+uint32_t lines_sent() {
+    return n_lines_sent;
+}
+uint32_t lines_acked() {
+    return n_lines_acked;
+}
+
 void send_line(const char* s, int timeout) {
+    ++n_lines_sent;
     fnc_send_line(s, timeout);
     dbg_println(s);
 }
@@ -200,14 +343,23 @@ const char* mode_string() {
     return myModes.c_str();
 }
 
-state_t previous_state;
-bool    awaiting_alarm = false;
+bool awaiting_alarm       = false;
+bool state_change_pending = false;  // Acted upon once the report is published
 
 extern "C" void show_state(const char* state_string) {
-    previous_state = state;
-    state_t new_state;
-    if (decode_state_string(state_string, new_state) && state != new_state) {
-        if (state == Disconnected) {
+    state_t     new_state;
+    const char* new_name;
+    if (!decode_state_string(state_string, new_state, new_name)) {
+        return;
+    }
+    // e.g. Hold:0 -> Hold:1 changes only the string
+    state_t old_state           = last_published->state;
+    back_snapshot->state_string = new_name;
+    back_snapshot->state        = new_state;
+    if (old_state != new_state) {
+        back_snapshot->previous_state = old_state;
+        if (old_state == Disconnected) {
+            n_lines_acked = n_lines_sent;        // Answers to a lost connection will not come
             fnc_realtime((realtime_cmd_t)0x0c);  // Ctrl-L - echo off
             send_line("$G");                     // Refresh GCode modes
             send_line("$G");                     // Refresh GCode modes
@@ -215,21 +367,27 @@ extern "C" void show_state(const char* state_string) {
             init_file_list();
             detect_homing_info();
         }
-        state = new_state;
-        if (state == Alarm && lastAlarm == 0) {  // Unknown
-            send_line("$A");                     // Get last alarm
+        if (new_state == Alarm && lastAlarm == 0) {  // Unknown
+            send_line("$A");                         // Get last alarm
             awaiting_alarm = true;
             return;
         }
-        act_on_state_change();
+        state_change_pending = true;
     }
 }
 
 extern "C" void handle_other(char* line) {
+    if (parse_config_tree_line(line)) {
+        return;
+    }
     if (*line == '$') {
         parse_dollar(line);
         return;
     }
+    if (strncmp(line, "[VER:", strlen("[VER:")) == 0) {
+        set_controller_version(line + strlen("[VER:"));
+        return;
+    }
     int alarmlen = strlen("Active alarm: ");
     if (strncmp(line, "Active alarm: ", alarmlen) == 0) {
         lastAlarm = atoi(line + alarmlen);
@@ -244,25 +402,60 @@ extern "C" void handle_other(char* line) {
 extern "C" void show_error(int error) {
     errorExpire = milliseconds() + 1000;
     lastError   = error;
-    current_scene->reDisplay();
+    post_event(ErrorEvent);
+    ++n_lines_acked;
+    config_line_acked();
 }
 
 extern "C" void show_timeout() {
     dbg_println("Timeout");
 }
-extern "C" void show_ok() {}
+extern "C" void show_ok() {
+    ++n_lines_acked;
+    config_line_acked();
+}
 
 extern "C" void end_status_report() {
-    current_scene->onDROChange();
+    change_mask_t changes = snapshot_changes(*last_published, *back_snapshot);
+    publish_snapshot();
+
+    check_feed(last_published->feed);
+
+    // The scene callbacks below run on this task, so they can use the
+    // new snapshot right away
+    latch_model();
+
+    // Scenes that redraw on a state change must see the new snapshot
+    if (state_change_pending) {
+        state_change_pending = false;
+        act_on_state_change();
+    }
+
+    // The scene decides whether the changes affect what it shows
+    int  frames    = frames_pushed;
+    bool was_dirty = current_scene->dirty();
+    current_scene->onDROChange(changes);
+    if (frames_pushed != frames || (current_scene->dirty() && !was_dirty)) {
+        ++frames_rendered;
+    } else {
+        ++frames_skipped;
+    }
+    if ((frames_rendered + frames_skipped) % 100 == 0) {
+        dbg_printf("Status reports: %d redrawn, %d skipped\n", frames_rendered, frames_skipped);
+    }
 }
 
 extern "C" void show_alarm(int alarm) {
     lastAlarm = alarm;
-    current_scene->reDisplay();
+    post_event(AlarmEvent);
 }
 
 extern "C" void show_gcode_modes(struct gcode_modes* modes) {
-    inInches = strcmp(modes->units, "In") == 0 || strcmp(modes->units, "G20") == 0;
+    bool was_inches = inInches;
+    inInches        = strcmp(modes->units, "In") == 0 || strcmp(modes->units, "G20") == 0;
+    if (inInches != was_inches) {
+        position_history.clear();  // The history is in display units
+    }
 
     myModes = modes->wcs;
     myModes += " ";
@@ -279,7 +472,7 @@ extern "C" void show_gcode_modes(struct gcode_modes* modes) {
     }
 
     mySelectedTool = modes->tool;
-    current_scene->reDisplay();
+    post_event(ModelChangedEvent);
 }
 
 int disconnect_ms = 0;
@@ -21,23 +21,55 @@ enum state_t {
     Disconnected,  // We can't talk to FluidNC
 };
 
+// Fields of a status report that can change.  end_status_report() passes
+// a mask of the ones that actually changed to Scene::onDROChange() so that
+// scenes can skip redrawing when nothing they show is different.
+typedef uint32_t change_mask_t;
+enum model_change_t : change_mask_t {
+    AxesChanged      = 0x3f,  // One bit per axis, see axis_changed()
+    OverridesChanged = 1 << 6,
+    FeedSpeedChanged = 1 << 7,
+    PinsChanged      = 1 << 8,
+    PercentChanged   = 1 << 9,
+    LimitsChanged    = 1 << 10,
+    ProbeChanged     = 1 << 11,
+    StateNameChanged = 1 << 12,
+};
+inline change_mask_t axis_changed(int axis) {
+    return 1 << axis;
+}
+
 // Variables and functions to model the state of the FluidNC controller
 
-extern state_t     state;
-extern state_t     previous_state;
-extern const char* my_state_string;
+// A consistent copy of the fields of one status report.  The parser
+// fills a back buffer and publishes it when the report ends; drawing
+// code reads the published snapshot via model() so it never sees a
+// partially-parsed report.  seq increases with every publication, so a
+// scene can tell whether it has already drawn a snapshot.
+struct ModelSnapshot {
+    uint32_t           seq            = 0;
+    state_t            state          = Idle;
+    state_t            previous_state = Idle;  // The state before the last change
+    const char*        state_string   = "N/C";
+    int                n_axes         = 3;
+    pos_t              axes[6]        = { 0 };
+    bool               limits[6]      = { false };
+    bool               probe          = false;
+    char               ctrl_pins[16]  = "";
+    file_percent_t     percent        = 0;    // percent complete of SD file
+    override_percent_t fro            = 100;  // Feed rate override
+    override_percent_t sro            = 100;  // Spindle override
+    uint32_t           feed           = 0;
+    uint32_t           speed          = 0;
+};
+
+// The renderer's snapshot.  A reference stays valid until latch_model().
+const ModelSnapshot& model();
+// Makes model() the newest published snapshot.  Called by the renderer
+// between frames, never while it holds a reference from model().
+void latch_model();
 
-extern int                n_axes;
-extern pos_t              myAxes[6];
-extern bool               myLimitSwitches[6];
-extern bool               myProbeSwitch;
-extern const char*        myCtrlPins;
 extern const char*        myFile;
-extern file_percent_t     myPercent;
-extern override_percent_t myFro;
-extern override_percent_t mySro;
-extern uint32_t           myFeed;
-extern uint32_t           mySpeed;
 extern int                lastAlarm;
 extern int                lastError;
 extern uint32_t           errorExpire;
@@ -46,14 +78,24 @@ extern uint32_t           mySelectedTool;
 
 int num_digits();
 
+// The position to show on a DRO.  With INTERPOLATE_DRO it is extrapolated
+// between status reports while the machine is moving.
+pos_t dro_position(int axis);
+bool  dro_interpolation_due();  // True once per UPDATE_RATE_MS while extrapolating
+
 void send_line(const char* s, int timeout = 2000);
 void send_linef(const char* fmt, ...);
 
+// Counts of lines sent and of their oks and errors.  The answer to the
+// line sent as number n is ack number n.
+uint32_t lines_sent();
+uint32_t lines_acked();
+
 const char* intToCStr(int val);
 const char* axisNumToCStr(int axis);
 char        axisNumToChar(int axis);
 
-state_t     decode_state_string(const char* state_string);
+bool        decode_state_string(const char* state_string, state_t& state, const char*& state_name);
 const char* decode_error_number(int error_num);
 const char* mode_string();
 
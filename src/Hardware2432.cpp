@@ -279,7 +279,8 @@ static uint8_t readPhysicalButtons() {
 
 void initButton(int n) {
     Point offset = layout->buttonOffset(n);
-    buttons.fillRect(offset.x, offset.y, 80, 80, BLACK);
+    // The button sprites match the display, so they take RGB565 colors
+    buttons.fillRect(offset.x, offset.y, 80, 80, themeColor565(BLACK));
     const int   radius = 28;
     const char* filename;
     int         color;
@@ -297,7 +298,7 @@ void initButton(int n) {
             filename = "/green_button.png";
             break;
     }
-    buttons.fillCircle(offset.x + button_half_wh, offset.y + button_half_wh, radius, color);
+    buttons.fillCircle(offset.x + button_half_wh, offset.y + button_half_wh, radius, themeColor565(color));
     // If the image file exists the image will overwrite the circle
     buttons.drawPngFile(LittleFS, filename, offset.x + 10, offset.y + 10, 60, 60, 0, 0, 0.0f, 0.0f, datum_t::top_left);
 }
@@ -314,12 +315,12 @@ void initLockedButtons() {
     locked_buttons.setColorDepth(display.getColorDepth());
     locked_buttons.createSprite(layout->buttonsWH.x, layout->buttonsWH.y);
 
-    locked_buttons.fillRect(0, 0, layout->buttonsWH.x, layout->buttonsWH.y, BLACK);
+    locked_buttons.fillRect(0, 0, layout->buttonsWH.x, layout->buttonsWH.y, themeColor565(BLACK));
 
     const int radius = 28;
     for (int i = 0; i < 3; i++) {
         Point offset = layout->buttonOffset(i);
-        locked_buttons.fillCircle(offset.x + button_half_wh, offset.y + button_half_wh, radius, DARKGREY);
+        locked_buttons.fillCircle(offset.x + button_half_wh, offset.y + button_half_wh, radius, themeColor565(DARKGREY));
     }
 }
 #endif
@@ -344,6 +345,7 @@ void base_display() {
     initLockedButtons();
 #endif
     redrawButtons(buttons);
+    invalidateDisplay();
 }
 void next_layout(int delta) {
     layout_num += delta;
@@ -514,10 +516,14 @@ void update_events() {
     }
 }
 
+static void beep_off(void* arg) {
+    noTone(BUZZER_CHANNEL);
+}
 void ackBeep() {
+    static timer_id_t beep_timer = 0;
+    cancel_timer(beep_timer);
     ledcWriteTone(BUZZER_CHANNEL, 1800);
-    delay(50);
-    noTone(BUZZER_CHANNEL);
+    beep_timer = set_timeout(50, beep_off);
 }
 
 void deep_sleep(int us) {}
@@ -13,7 +13,7 @@ public:
         drawBackground(BROWN);
         int pos = 20;
         for (; line = *msg, line; ++msg) {
-            centered_text(line, pos, WHITE, TINY);
+            centered_label(line, pos, WHITE, TINY);
             pos += 28;
         }
         drawButtonLegends("", "", "Back");
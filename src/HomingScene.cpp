@@ -25,7 +25,7 @@ bool is_homed(int axis) {
 }
 void set_axis_homed(int axis) {
     homed_axes |= 1 << axis;
-    current_scene->reDisplay();
+    post_event(ModelChangedEvent);
 }
 
 void detect_homing_info() {
@@ -34,6 +34,7 @@ void detect_homing_info() {
         homing_allows[i].init();
     }
     homed_axes = 0;
+    sync_config_tree("$/axes");
 }
 bool can_home(int i) {
     // Cannot home if cycle == 0 and !allow_single_axis
@@ -56,7 +57,7 @@ public:
 
     bool is_homing(int axis) { return can_home(axis) && (_axis_to_home == -1 || _axis_to_home == axis); }
     void onEntry(void* arg) override {
-        if (state == Idle && _auto) {
+        if (model().state == Idle && _auto) {
             pop_scene();
         }
         const char* s = static_cast<const char*>(arg);
@@ -65,27 +66,27 @@ public:
 
     void onStateChange(state_t old_state) override {
 #ifdef AUTO_HOMING_RETURN
-        if (old_state == Homing && state == Idle && _auto) {
+        if (old_state == Homing && model().state == Idle && _auto) {
             pop_scene();
         }
 #endif
     }
     void onDialButtonPress() override { pop_scene(); }
     void onGreenButtonPress() override {
-        if (state == Idle || state == Alarm) {
+        if (model().state == Idle || model().state == Alarm) {
             if (_axis_to_home != -1) {
                 send_linef("$H%c", axisNumToChar(_axis_to_home));
             } else {
                 send_line("$H");
             }
-        } else if (state == Cycle) {
+        } else if (model().state == Cycle) {
             fnc_realtime(FeedHold);
-        } else if (state == Hold || state == DoorClosed) {
+        } else if (model().state == Hold || model().state == DoorClosed) {
             fnc_realtime(CycleStart);
         }
     }
     void onRedButtonPress() override {
-        if (state == Homing || state == Alarm) {
+        if (model().state == Homing || model().state == Alarm) {
             fnc_realtime(Reset);
         }
     }
@@ -100,20 +101,26 @@ public:
         } while (!can_home(_axis_to_home));
     }
     void onTouchClick() {
-        if (state == Idle || state == Homing || state == Alarm) {
+        if (model().state == Idle || model().state == Homing || model().state == Alarm) {
             increment_axis_to_home();
-            reDisplay();
+            invalidate();
             ackBeep();
         }
     }
 
     void onEncoder(int delta) override {
         increment_axis_to_home();
-        reDisplay();
+        invalidate();
+    }
+    void onDROChange(change_mask_t changes) override {  // also covers any status change
+        if (!snapshotDrawn() && (changes & (AxesChanged | LimitsChanged | PinsChanged | StateNameChanged))) {
+            invalidate();
+        }
     }
-    void onDROChange() { reDisplay(); }  // also covers any status change
 
     void reDisplay() {
+        const ModelSnapshot& m = snapshot();
+
         background();
         drawMenuTitle(current_scene->name());
         drawStatus();
@@ -123,13 +130,13 @@ public:
         const char* orangeLabel = "";
         std::string green       = "Home ";
 
-        if (false && state == Homing) {
+        if (false && m.state == Homing) {
             DRO dro(16, 68, 210, 32);
             for (size_t axis = 0; axis < HOMING_N_AXIS; axis++) {
                 dro.draw(axis, -1, true);
             }
 
-        } else if (state == Idle || state == Homing || state == Alarm) {
+        } else if (m.state == Idle || m.state == Homing || m.state == Alarm) {
             DRO dro(16, 68, 210, 32);
             for (int axis = 0; axis < HOMING_N_AXIS; ++axis) {
                 dro.drawHoming(axis, is_homing(axis), is_homed(axis));
@@ -148,15 +155,15 @@ public:
             button.draw("Home Y", _axis_to_home == 1);
             button.draw("Home Z", _axis_to_home == 2);
             LED led(x - 16, y + height / 2, 10, button.gap());
-            led.draw(myLimitSwitches[0]);
-            led.draw(myLimitSwitches[1]);
-            led.draw(myLimitSwitches[2]);
+            led.draw(m.limits[0]);
+            led.draw(m.limits[1]);
+            led.draw(m.limits[2]);
 #endif
 
-            if (state == Homing) {
+            if (m.state == Homing) {
                 redLabel = "E-Stop";
             } else {
-                if (state == Alarm && (strchr(myCtrlPins, 'D') == NULL)) {  // You can reset alarms if door is not active
+                if (m.state == Alarm && (strchr(m.ctrl_pins, 'D') == NULL)) {  // You can reset alarms if door is not active
                     redLabel = "Reset";
                 }
                 if (_axis_to_home == -1) {
@@ -178,9 +185,9 @@ public:
             centered_text("Invalid State", 105, WHITE, MEDIUM);
             centered_text("For Homing", 145, WHITE, MEDIUM);
             redLabel = "E-Stop";
-            if (state == Cycle) {
+            if (m.state == Cycle) {
                 grnLabel = "Hold";
-            } else if (state == Hold || state == DoorClosed) {
+            } else if (m.state == Hold || m.state == DoorClosed) {
                 grnLabel = "Resume";
             }
         }
@@ -32,7 +32,8 @@ void MacroItem::show(const Point& where) {
         text(name(), where + Point { 0, 6 }, BLACK, MEDIUM, middle_center);
         text(extra, where - Point { 0, 16 }, BLACK, TINY, middle_center);
     } else {
-        text(name(), where, WHITE, SMALL, middle_center);
+        Point xy = where.to_display();
+        label(name().c_str(), xy.x, xy.y, WHITE, SMALL, middle_center);
     }
 }
 
@@ -40,6 +41,9 @@ class MacroMenu : public Menu {
 private:
     bool        _reading = true;
     std::string _error_string;
+#ifdef SMOOTH_SCROLL
+    ScrollOffset _scroll;
+#endif
 
 public:
     MacroMenu() : Menu("Macros") {}
@@ -82,7 +86,7 @@ public:
     }
 
     void onGreenButtonPress() {
-        if (state != Idle) {
+        if (model().state != Idle) {
             return;
         }
         if (num_items()) {
@@ -104,18 +108,25 @@ public:
                 text(_reading ? "Reading Macros" : "No Macros", { 0, 0 }, WHITE, SMALL, middle_center);
             }
         } else {
+            Point shift { 0, 0 };
+#ifdef SMOOTH_SCROLL
+            if (_scroll.step()) {
+                shift.y = _scroll.value();
+                invalidateAfter(_scroll.next_step_ms());  // When the offset next changes
+            }
+#endif
             if (_selected > 1) {
-                _items[_selected - 2]->show({ 0, 80 });
+                _items[_selected - 2]->show(Point { 0, 80 } + shift);
             }
             if (_selected > 0) {
-                _items[_selected - 1]->show({ 0, 45 });
+                _items[_selected - 1]->show(Point { 0, 45 } + shift);
             }
-            _items[_selected]->show({ 0, 0 });
+            _items[_selected]->show(shift);
             if (_selected < num_items() - 1) {
-                _items[_selected + 1]->show({ 0, -45 });
+                _items[_selected + 1]->show(Point { 0, -45 } + shift);
             }
             if (_selected < num_items() - 2) {
-                _items[_selected + 2]->show({ 0, -80 });
+                _items[_selected + 2]->show(Point { 0, -80 } + shift);
             }
         }
         buttonLegends();
@@ -126,7 +137,7 @@ public:
         const char* orangeLabel = "";
         const char* grnLabel    = "";
 
-        if (state == Idle) {
+        if (model().state == Idle) {
             if (num_items()) {
                 orangeLabel = "Run";
                 grnLabel    = "Load";
@@ -143,6 +154,9 @@ public:
         if (_selected == num_items() && delta >= 0) {
             return;
         }
+#ifdef SMOOTH_SCROLL
+        int previous = _selected;
+#endif
         if (_selected != -1) {
             _items[_selected]->unhighlight();
         }
@@ -154,13 +168,20 @@ public:
             _selected = num_items() - 1;
         }
         _items[_selected]->highlight();
-        reDisplay();
+#ifdef SMOOTH_SCROLL
+        // Slide the new selection in from where it was, at most one row.
+        // With no previous selection there is nothing to slide from.
+        if (previous != -1) {
+            _scroll.add((previous - _selected) * 45, 45);
+        }
+#endif
+        invalidate();
     }
 
     int touchedItem(int x, int y) override { return -1; };
 
     void onStateChange(state_t old_state) {
-        if (state == Cycle) {
+        if (model().state == Cycle) {
             push_scene(&statusScene);
         }
     }
@@ -180,7 +201,7 @@ public:
                 drawFilledCircle({ dx, dy }, 8, WHITE);
             }
         }
-        if (state != Idle) {
+        if (model().state != Idle) {
             drawStatus();
         }
 
@@ -4,6 +4,8 @@
 #include "Menu.h"
 #include "System.h"
 #include "Drawing.h"
+#include "SpriteCache.h"
+#include "Spans.h"
 
 void do_nothing(void* foo) {}
 
@@ -11,13 +13,62 @@ void RoundButton::show(const Point& where) {
     drawOutlinedCircle(where, _radius, _highlighted ? _hl_fill_color : _fill_color, _highlighted ? _hl_outline_color : _outline_color);
     text(name().substr(0, 1), where, _highlighted ? MAROON : WHITE, MEDIUM);
 }
+// Icons are cached already composited onto their background circle,
+// which is the same for every redraw in a given button state
+static SpriteCache icon_cache(40 * 1024, 256 * 1024);
+static const int   icon_transparent = MAGENTA;
+static const int   icon_background  = BLACK;  // What background() draws under menus
+
+// Draws the spans from Spans.h as lines on an icon sprite
+struct icon_fill {
+    LGFX_Sprite* sprite;
+    int          center;
+    int          color;
+    void operator()(int dy, int left, int right) const { sprite->drawFastHLine(center + left, center + dy, right - left + 1, color); }
+};
+
+// The icon is decoded over the menu background, so its partly
+// transparent edge pixels blend with the color they will be shown on.
+// Only the background left outside the circle becomes transparent.
+static void key_outside_circle(LGFX_Sprite* icon, int radius, uint32_t background) {
+    int size = icon->width();
+    for (int y = 0; y < size; y++) {
+        int half = disc_half_width(radius, y - size / 2);
+        for (int x = 0; x < size; x++) {
+            int dx = x - size / 2;
+            if ((half < 0 || dx < -half || dx > half) && icon->readPixelValue(x, y) == background) {
+                icon->drawPixel(x, y, icon_transparent);
+            }
+        }
+    }
+}
+
 void ImageButton::show(const Point& where) {
-    if (_highlighted) {
-        drawFilledCircle(where, _radius + 3, _disabled ? DARKGREY : _outline_color);
-    } else {
-        drawFilledCircle(where, _radius - 2, _disabled ? DARKGREY : LIGHTGREY);
+    int   color   = _disabled ? DARKGREY : (_highlighted ? _outline_color : LIGHTGREY);
+    int   radius  = _highlighted ? _radius + 3 : _radius - 2;
+    Point display = where.to_display();
+    drawRing(display.x, display.y, radius, 0, color);  // The same pixels as the icon's circle
+
+    char key[64];
+    snprintf(key, sizeof(key), "%s:%d:%d", _filename, radius, color);
+    LGFX_Sprite* icon = icon_cache.find(key);
+    if (!icon) {
+        int size = _radius * 2;
+        icon     = icon_cache.create(key, size, size);
+        if (!icon) {
+            drawPngFile(_filename, where);
+            return;
+        }
+        icon->fillSprite(icon_background);
+        uint32_t background = icon->readPixelValue(0, 0);
+        ring_spans(radius, 0, icon_fill { icon, size / 2, color });
+        drawPngFile(icon, _filename, 0, 0);
+        key_outside_circle(icon, radius, background);
+        if (icon_cache.misses % 8 == 0) {
+            dbg_printf("Icon cache: %d decodes, %d hits, %d evictions\n", icon_cache.misses, icon_cache.hits, icon_cache.evictions);
+        }
     }
-    drawPngFile(_filename, where);
+    icon->pushSprite(&canvas, display.x - _radius, display.y - _radius, icon_transparent);
 }
 void RectangularButton::show(const Point& where) {
     drawOutlinedRect(where, _width, _height, _highlighted ? BLUE : _outline_color, _bg_color);
@@ -61,5 +112,5 @@ void Menu::rotate(int delta) {
     } while (_selected != previous);
 
     _items[_selected]->highlight();
-    reDisplay();
+    invalidate();
 }
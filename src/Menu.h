@@ -201,7 +201,7 @@ public:
         }
         _selected = item;
         _items[item]->highlight();
-        reDisplay();
+        invalidate();
     }
     void onTouchClick() override {
         if (_help_text && touchIsCenter()) {
@@ -27,7 +27,6 @@ public:
     LB(const char* text, Scene* scene, color_t base_color) : RoundButton(text, scene, buttonRadius, base_color, GREEN, BLUE, WHITE) {}
 };
 
-constexpr int LIGHTYELLOW = 0xFFF0;
 class IB : public ImageButton {
 public:
     IB(const char* text, callback_t callback, const char* filename) : ImageButton(text, callback, filename, buttonRadius, WHITE) {}
@@ -94,24 +93,24 @@ public:
     }
     void onEntry(void* arg) {
         PieMenu::onEntry(arg);
-        if (state == Disconnected) {
+        if (model().state == Disconnected) {
             disableIcons();
         } else {
             enableIcons();
         }
     }
     void onStateChange(state_t old_state) override {
-        if (state != Disconnected) {
+        if (model().state != Disconnected) {
             enableIcons();
             if (old_state == Disconnected) {
 #ifdef AUTO_JOG_SCENE
-                if (state == Idle) {
+                if (model().state == Idle) {
                     push_scene(&jogScene);
                     return;
                 }
 #endif
 #ifdef AUTO_HOMING_SCENE
-                if (state == Alarm && lastAlarm == 14) {  // Unknown or Unhomed
+                if (model().state == Alarm && lastAlarm == 14) {  // Unknown or Unhomed
                     push_scene(&homingScene, (void*)"auto");
                     return;
                 }
@@ -124,15 +123,15 @@ public:
 #ifdef I2C_BUTTONS
     // x/y/z buttons enter jog scene
     void onXButtonPressed() {      
-        if (state == Idle)
+        if (model().state == Idle)
             push_scene(&jogScene);
     }
     void onYButtonPressed() {      
-        if (state == Idle)
+        if (model().state == Idle)
             push_scene(&jogScene);
     }
     void onZButtonPressed() {      
-        if (state == Idle)
+        if (model().state == Idle)
             push_scene(&jogScene);
     }
 #endif
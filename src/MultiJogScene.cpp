@@ -57,12 +57,14 @@ public:
     }
 
     void reDisplay() {
+        snapshot();  // The DROs and status are drawn from it
+
         background();
         drawBackground(_bg_image);
         drawMenuTitle(current_scene->name());
         drawStatus();
 
-        if (state != Jog && _cancelling) {
+        if (model().state != Jog && _cancelling) {
             _cancelling = false;
         }
         if (_cancelling || _cancel_held) {
@@ -72,7 +74,7 @@ public:
             for (size_t axis = 0; axis < num_axes; axis++) {
                 dro.draw(axis, _dist_index[axis], selected(axis));
             }
-            if (state == Jog) {
+            if (model().state == Jog) {
                 if (!_continuous) {
                     centered_text("Touch to cancel jog", 185, YELLOW, TINY);
                 }
@@ -178,7 +180,7 @@ public:
         }
     }
     void cancel_jog() {
-        if (state == Jog) {
+        if (model().state == Jog) {
             fnc_realtime(JogCancel);
             _continuous = false;
             _cancelling = true;
@@ -220,36 +222,36 @@ public:
     }
     void touch_top() {
         prev_axis();
-        reDisplay();
+        invalidate();
     }
     void touch_bottom() {
         next_axis();
-        reDisplay();
+        invalidate();
     }
     void touch_left() {
         increment_distance();
-        reDisplay();
+        invalidate();
     }
     void touch_right() {
         decrement_distance();
-        reDisplay();
+        invalidate();
     }
 
     void onTouchPress() {
-        if (state == Jog) {
+        if (model().state == Jog) {
             _cancel_held = true;
             cancel_jog();
         }
-        reDisplay();
+        invalidate();
     }
 
     void onTouchRelease() {
         _cancel_held = false;
-        reDisplay();
+        invalidate();
     }
 
     void onTouchClick() {
-        if (state == Jog || _cancelling || _cancel_held) {
+        if (model().state == Jog || _cancelling || _cancel_held) {
             return;
         }
         if (touchIsCenter()) {
@@ -289,7 +291,7 @@ public:
             } else {
                 select(axis);
             }
-            reDisplay();
+            invalidate();
             return;
         }
 #if 0
@@ -355,7 +357,7 @@ public:
     }
 
     void onGreenButtonPress() {
-        if (state == Idle) {
+        if (model().state == Idle) {
             start_button_jog(false);
         }
     }
@@ -363,7 +365,7 @@ public:
         cancel_jog();
     }
     void onRedButtonPress() {
-        if (state == Idle) {
+        if (model().state == Idle) {
             start_button_jog(true);
         }
     }
@@ -377,9 +379,12 @@ public:
         }
     }
 
-    void onDROChange() {
-        reDisplay();
+    void onDROChange(change_mask_t changes) override {
+        if (!snapshotDrawn() && (changes & (AxesChanged | StateNameChanged))) {
+            invalidate();
+        }
     }
+    void onDROInterpolate() override { invalidate(); }
     void onLimitsChange() {
         reDisplay();
     }
@@ -5,22 +5,13 @@
 #include "System.h"
 #include "Drawing.h"
 #include "polar.h"
+#include <algorithm>
 
 void PieMenu::calculatePositions() {
-    _num_slopes = num_items() / 2;  // Rounded down
-
-    _slopes.clear();
     int dtheta = 360 / num_items();
 
-    int angle = 90 - (dtheta / 2);
-    for (size_t i = 0; i < _num_slopes; i++) {
-        int slope = r_degrees_to_slope(1024, angle);
-        _slopes.push_back(slope);
-        angle -= dtheta;
-    }
-
     int layout_radius = display_short_side() / 2 - _item_radius - 3;
-    angle             = 90;
+    int angle         = 90;
     for (size_t i = 0; i < num_items(); i++) {
         int x, y;
         r_degrees_to_xy(layout_radius, angle, &x, &y);
@@ -28,45 +19,39 @@ void PieMenu::calculatePositions() {
         setPosition(i, center);
         angle -= dtheta;
     }
+
+    // Each bucket goes to the item whose center direction is nearest
+    const int full   = 1 << REVS_BITS;
+    const int bucket = full / hit_buckets;
+    _hit_items.assign(hit_buckets, 0);
+    for (int b = 0; b < hit_buckets; b++) {
+        int direction = b * bucket + bucket / 2;
+        int nearest   = full;
+        for (int i = 0; i < num_items(); i++) {
+            int d = (direction - to_revs(90 - i * dtheta, 360)) & (full - 1);
+            d     = std::min(d, full - d);
+            if (d < nearest) {
+                nearest       = d;
+                _hit_items[b] = i;
+            }
+        }
+    }
 }
 
 int PieMenu::touchedItem(int x, int y) {
     // Convert from screen coordinates to 0,0 in the center
     Point ctr = Point { x, y }.from_display();
 
-    fnc_realtime(StatusReport);  // used to update if status is out of sync
-
     x = ctr.x;
     y = ctr.y;
 
     int dead_radius = display_short_side() / 2 - _item_radius * 2;
 
-    if ((x * x + y * y) < (dead_radius * dead_radius)) {
+    if ((x * x + y * y) < (dead_radius * dead_radius) || _hit_items.empty()) {
         return -1;  // In middle dead zone
     }
-    if (x == 0) {
-        x = 1;  // Don't divide by zero
-    }
-    int slope = y * 1024 / x;
-    if (x < 0) {
-        slope = -slope;
-    }
-    if (slope > _slopes[0]) {
-        // Top item
-        return 0;
-    }
-    // Side items
-    size_t i;
-    for (i = 1; i < _num_slopes; ++i) {
-        if (slope > _slopes[i]) {
-            return x > 0 ? i : num_items() - i;
-        }
-    }
-    // If num_items() is even, return the bottom item  (i == num_items()-i)
-    // If it is odd, return one of two bottom items stradding -Y axis
-
-    reDisplay();
-    return x > 0 ? i : num_items() - i;
+    int direction = iatan2(x, y) & ((1 << REVS_BITS) - 1);
+    return _hit_items[direction * hit_buckets >> REVS_BITS];
 }
 void PieMenu::menuBackground() {
     background();
@@ -77,6 +62,7 @@ void PieMenu::menuBackground() {
 void PieMenu::onTouchFlick() {
     int item = touchedItem(touchX, touchY);
     if (item != -1) {
+        fnc_realtime(StatusReport);  // In case the status is out of sync
         select(item);
         ackBeep();
         invoke();
@@ -101,6 +87,7 @@ void PieMenu::onTouchClick() {
 
     int item = touchedItem(touchX, touchY);
     if (item != -1) {
+        fnc_realtime(StatusReport);  // In case the status is out of sync
         select(item);
         invoke();
     }
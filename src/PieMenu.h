@@ -9,9 +9,11 @@
 class PieMenu : public Menu {
 private:
     int _item_radius;
-    int _num_slopes;
 
-    std::vector<int> _slopes;  // Slopes of lines dividing switch positions
+    // The item for each direction from the center, in 8 octants of 32
+    // buckets, so a touch is looked up instead of searched for
+    static const int    hit_buckets = 256;
+    std::vector<int8_t> _hit_items;
 
 public:
     PieMenu(const char* name, int item_radius, const char** help_text = nullptr) : Menu(name, help_text), _item_radius(item_radius) {}
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "PositionHistory.h"
+#include <math.h>
+#include <string.h>
+
+static float pos_to_float(pos_t pos) {
+#ifdef E4_POS_T
+    return pos / 10000.0f;
+#else
+    return pos;
+#endif
+}
+
+static pos_t float_to_pos(float f) {
+#ifdef E4_POS_T
+    return (pos_t)lroundf(f * 10000.0f);
+#else
+    return f;
+#endif
+}
+
+void PositionHistory::record(int ms, const pos_t* axes, int n_axes) {
+    if (n_axes > MAX_AXES) {
+        n_axes = MAX_AXES;
+    }
+    if (n_axes != _n_axes) {
+        clear();  // Samples with a different axis count are not comparable
+        _n_axes = n_axes;
+    }
+    _head       = (_head + 1) % SIZE;
+    sample_t& s = _samples[_head];
+    s.ms        = ms;
+    memcpy(s.axes, axes, n_axes * sizeof(*axes));
+    if (_count < SIZE) {
+        ++_count;
+    }
+}
+
+float PositionHistory::velocity(int axis, int age) const {
+    if (axis >= _n_axes || _count < age + 2) {
+        return 0.0f;
+    }
+    const sample_t& now    = sample(age);
+    const sample_t& before = sample(age + 1);
+
+    int dt = now.ms - before.ms;
+    if (dt <= 0) {
+        return 0.0f;
+    }
+    return (pos_to_float(now.axes[axis]) - pos_to_float(before.axes[axis])) * 1000.0f / dt;
+}
+
+float PositionHistory::path_feed() const {
+    float sum = 0.0f;
+    for (int axis = 0; axis < _n_axes; axis++) {
+        float v = velocity(axis);
+        sum += v * v;
+    }
+    return sqrtf(sum) * 60.0f;
+}
+
+bool PositionHistory::moving(int ms) const {
+    if (_count < 2) {
+        return false;
+    }
+    int interval = sample(0).ms - sample(1).ms;
+    if ((ms - sample(0).ms) > 2 * interval) {
+        return false;  // Reports have stopped
+    }
+    for (int axis = 0; axis < _n_axes; axis++) {
+        if (sample(0).axes[axis] != sample(1).axes[axis]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+pos_t PositionHistory::extrapolate(int axis, int ms) const {
+    if (_count == 0 || axis >= _n_axes) {
+        return 0;
+    }
+    const sample_t& last = sample(0);
+    if (_count < 2) {
+        return last.axes[axis];
+    }
+    int elapsed  = ms - last.ms;
+    int interval = last.ms - sample(1).ms;
+    if (elapsed <= 0) {
+        return last.axes[axis];
+    }
+    if (elapsed > interval) {
+        elapsed = interval;  // Don't run past where the next report is due
+    }
+    return last.axes[axis] + float_to_pos(velocity(axis) * elapsed / 1000.0f);
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// A short ring buffer of timestamped DRO positions, from which the
+// velocity and path feed of the machine can be derived, and from which
+// positions can be extrapolated between status reports.
+
+#pragma once
+
+#include "GrblParserC.h"
+
+class PositionHistory {
+public:
+    static const int MAX_AXES = 6;
+
+private:
+    static const int SIZE = 8;
+
+    struct sample_t {
+        int   ms;
+        pos_t axes[MAX_AXES];
+    };
+
+    sample_t _samples[SIZE];
+    int      _head   = 0;
+    int      _count  = 0;
+    int      _n_axes = 0;
+
+    // age 0 is the newest sample
+    const sample_t& sample(int age) const { return _samples[(_head - age + SIZE) % SIZE]; }
+
+public:
+    void record(int ms, const pos_t* axes, int n_axes);
+    void clear() { _count = 0; }
+
+    // Units per second over the interval ending at sample age
+    float velocity(int axis, int age = 0) const;
+
+    // Units per minute along the path, comparable to the reported feed rate
+    float path_feed() const;
+
+    // Position at time ms assuming the last velocity continues, but
+    // no further than one report interval past the newest sample
+    pos_t extrapolate(int axis, int ms) const;
+
+    // True if the newest samples show movement and are recent enough to extrapolate from
+    bool moving(int ms) const;
+};
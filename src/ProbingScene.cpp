@@ -24,7 +24,7 @@ public:
 
     void onGreenButtonPress() {
         // G38.2 G91 F80 Z-20 P8.00
-        switch (state) {
+        switch (model().state) {
             case Idle:
                 send_linef("G38.2G91F%d%c%dP%s", _rate, axisNumToChar(_axis), _travel, e4_to_cstr(_offset, 2));
                 break;
@@ -43,14 +43,14 @@ public:
 
     void onRedButtonPress() {
         // G38.2 G91 F80 Z-20 P8.00
-        if (state == Cycle || state == Alarm) {
+        if (model().state == Cycle || model().state == Alarm) {
             fnc_realtime(Reset);            
             return;
-        } else if (state == Idle) {
+        } else if (model().state == Idle) {
             int retract = _travel < 0 ? _retract : -_retract;
             send_linef("$J=G91F1000%c%d", axisNumToChar(_axis), retract);
             return;
-        } else if (state == Hold || state == DoorClosed) {
+        } else if (model().state == Hold || model().state == DoorClosed) {
             fnc_realtime(Reset);
         }
     }
@@ -58,11 +58,15 @@ public:
     void onTouchClick() {
         // Rotate through the items to be adjusted.
         rotateNumberLoop(selection, 1, 0, 4);
-        reDisplay();
+        invalidate();
         ackBeep();
     }
 
-    void onDROChange() { reDisplay(); }
+    void onDROChange(change_mask_t changes) override {
+        if (!snapshotDrawn() && (changes & (AxesChanged | LimitsChanged | ProbeChanged | StateNameChanged))) {
+            invalidate();
+        }
+    }
 
     void onEncoder(int delta) {
         if (abs(delta) > 0) {
@@ -93,7 +97,7 @@ public:
                     rotateNumberLoop(_axis, 1, 0, 2);
                     setPref("Axis", _axis);
             }
-            reDisplay();
+            invalidate();
         }
     }
     void onEntry(void* arg) override {
@@ -108,6 +112,8 @@ public:
     }
 
     void reDisplay() {
+        const ModelSnapshot& m = snapshot();
+
         background();
         drawMenuTitle(current_scene->name());
         drawStatus();
@@ -115,7 +121,7 @@ public:
         const char* grnLabel = "";
         const char* redLabel = "";
 
-        if (state == Idle) {
+        if (m.state == Idle) {
             int    x      = 40;
             int    y      = 62;
             int    width  = display_short_side() - (x * 2);
@@ -131,12 +137,12 @@ public:
             button.draw("Axis", axisNumToCStr(_axis), selection == 4);
 
             //LED led(x - 20, y + height / 2, 10, button.gap());
-            //led.draw(myProbeSwitch);
+            //led.draw(model().probe);
 
             grnLabel = "Probe";
             redLabel = "Retract";
         } else {
-            if (state == Jog || state == Alarm) {  // there is no Probing state, so Cycle is a valid state on this
+            if (m.state == Jog || m.state == Alarm) {  // there is no Probing state, so Cycle is a valid state on this
                 //centered_text("Invalid State", 105, WHITE, MEDIUM);
                 //centered_text("For Probing", 145, WHITE, MEDIUM);
                 redLabel = "Reset";
@@ -147,7 +153,7 @@ public:
                 int y      = 82 - height / 2;
 
                 LED led(120, 190, 10, 5);
-                led.draw(myProbeSwitch);
+                led.draw(m.probe);
 
                 int width = display_short_side() - x * 2;
                 DRO dro(x, y, width, height);
@@ -155,7 +161,7 @@ public:
                 dro.draw(1, _axis == 1);
                 dro.draw(2, _axis == 2);
 
-                switch (state) {
+                switch (m.state) {
                     case Cycle:
                         redLabel = "E-Stop";
                         grnLabel = "Hold";
@@ -8,6 +8,8 @@
 #    include <sys/stat.h>
 #    include <sys/types.h>
 #endif
+#include <algorithm>
+#include <string>
 #include <vector>
 
 extern Scene homingScene;
@@ -25,10 +27,11 @@ std::vector<Scene*> scene_stack;
 void activate_scene(Scene* scene, void* arg) {
     if (current_scene) {
         current_scene->onExit();
+        cancel_timers(current_scene);
     }
     current_scene = scene;
     current_scene->onEntry(arg);
-    current_scene->reDisplay();
+    current_scene->invalidate();
 }
 void push_scene(Scene* scene, void* arg) {
     scene_stack.push_back(current_scene);
@@ -120,7 +123,8 @@ void dispatch_button(bool pressed, bool hold, int button) {
             break;
     }
 }
-void dispatch_touch() {
+// Returns true if the touch state changed
+bool dispatch_touch() {
     static m5::touch_state_t last_touch_state = {};
 
     auto t = touch.getDetail();
@@ -131,7 +135,7 @@ void dispatch_touch() {
         int delta;
         if (screen_encoder(t.x, t.y, delta) && t.state == m5::touch_state_t::touch) {
             current_scene->onEncoder(delta);
-            return;
+            return true;
         }
         int button;
         if (screen_button_touched(t.state == m5::touch_state_t::touch, t.x, t.y, button)) {
@@ -140,10 +144,10 @@ void dispatch_touch() {
             } else if (t.state == m5::touch_state_t::none) {
                 dispatch_button(false, false, button);
             }
-            return;
+            return true;
         }
         if (touchX < 0) {
-            return;
+            return true;
         }
         if (t.state == m5::touch_state_t::touch) {
             current_scene->onTouchPress();
@@ -176,7 +180,9 @@ void dispatch_touch() {
                 current_scene->onTouchFlick();
             }
         }
+        return true;
     }
+    return false;
 }
 
 ActionHandler action = nullptr;
@@ -185,9 +191,90 @@ void schedule_action(ActionHandler _action) {
     action = _action;
 }
 
+static uint8_t     posted_events = 0;
+static std::string posted_error;
+
+void post_event(ui_event_t event) {
+    posted_events |= event;
+}
+void post_error(const char* errstr) {
+    posted_error = errstr;
+    post_event(ErrorEvent);
+}
+
+static void deliver_posted_events() {
+    uint8_t events = posted_events;
+    if (!events) {
+        return;
+    }
+    posted_events = 0;
+
+    int frames = frames_pushed;
+    if (events & FilesListEvent) {
+        current_scene->onFilesList();
+    }
+    if (events & AlarmEvent) {
+        current_scene->onAlarm();
+    }
+    if ((events & ErrorEvent) && posted_error.length()) {
+        std::string errstr;
+        errstr.swap(posted_error);
+        current_scene->onError(errstr.c_str());
+    }
+    // Redraw once for everything else unless a handler already did
+    if ((events & (ModelChangedEvent | ConfigArrivedEvent | ErrorEvent | AlarmEvent)) && frames_pushed == frames) {
+        current_scene->invalidate();
+    }
+}
+
+// How long input handlers take.  Handlers invalidate() instead of
+// drawing, so every input path should land in the first bucket; the
+// count of handlers that drew a frame shows any that still draw.
+static const int stall_buckets                 = 6;
+static const int stall_limit_us[stall_buckets] = { 1000, 2000, 5000, 10000, 50000, 0 };
+static int       stall_counts[stall_buckets]   = {};
+static int       stall_worst_us                = 0;
+static int       stall_frames                  = 0;
+static int       stall_report_ms               = 0;
+
+static void record_input_time(int us, bool drew) {
+    if (drew) {
+        ++stall_frames;
+    }
+    int b = 0;
+    while (stall_limit_us[b] && us >= stall_limit_us[b]) {
+        ++b;
+    }
+    ++stall_counts[b];
+    stall_worst_us = std::max(stall_worst_us, us);
+
+    int now = milliseconds();
+    if (now - stall_report_ms >= 10000) {
+        dbg_printf("Input: <1ms %d, 1-2ms %d, 2-5ms %d, 5-10ms %d, 10-50ms %d, >50ms %d, worst %d us, %d drew a frame\n",
+                   stall_counts[0],
+                   stall_counts[1],
+                   stall_counts[2],
+                   stall_counts[3],
+                   stall_counts[4],
+                   stall_counts[5],
+                   stall_worst_us,
+                   stall_frames);
+        stall_report_ms = now;
+    }
+}
+
 void dispatch_events() {
     update_events();
+    latch_model();
+    run_timers();
+    if (!current_scene) {
+        return;  // Still starting up
+    }
     if (!ui_locked()) {
+        int  start_us = microseconds();
+        int  frames   = frames_pushed;
+        bool handled  = false;
+
         static int16_t oldEncoder   = 0;
         int16_t        newEncoder   = get_encoder();
         int16_t        encoderDelta = newEncoder - oldEncoder;
@@ -197,6 +284,7 @@ void dispatch_events() {
             int16_t scaledDelta = current_scene->scale_encoder(encoderDelta);
             if (scaledDelta) {
                 current_scene->onEncoder(scaledDelta);
+                handled = true;
             }
         }
 
@@ -204,13 +292,28 @@ void dispatch_events() {
         int  button;
         if (switch_button_touched(pressed, hold, button)) {
             dispatch_button(pressed, hold, button);
+            handled = true;
+        }
+
+        handled |= dispatch_touch();
+
+        if (handled) {
+            record_input_time(microseconds() - start_us, frames_pushed != frames);
         }
+    }
+
+    deliver_posted_events();
 
-        dispatch_touch();
+    if (dro_interpolation_due()) {
+        current_scene->onDROInterpolate();
+    }
+
+    if (current_scene->frameDue()) {
+        current_scene->reDisplay();
     }
 
     if (!fnc_is_connected()) {
-        if (state != Disconnected) {
+        if (model().state != Disconnected) {
             set_disconnected_state();
             extern Scene menuScene;
             activate_at_top_level(&menuScene);
@@ -278,10 +381,42 @@ int Scene::scale_encoder(int delta) {
     return res;
 }
 
+static int last_frame_ms = 0;
+
+bool Scene::frameDue() {
+    if (!_dirty || (milliseconds() - last_frame_ms) < UPDATE_RATE_MS) {
+        return false;
+    }
+    _dirty     = false;
+    _scheduled = true;
+    return true;
+}
+
+static void invalidate_scene(void* scene) {
+    static_cast<Scene*>(scene)->invalidate();
+}
+void Scene::invalidateAfter(int ms) {
+    cancel_timer(_frame_timer);
+    _frame_timer = after(ms, invalidate_scene, this);
+}
+
+void Scene::rendered() {
+    if (!_scheduled && !_dirty) {
+        ++_frames_requested;  // A direct reDisplay()
+    }
+    _dirty        = false;
+    _scheduled    = false;
+    last_frame_ms = milliseconds();
+    if (++_frames_rendered % 100 == 0) {
+        dbg_printf("%s: %d frames requested, %d rendered\n", name(), _frames_requested, _frames_rendered);
+    }
+}
+
 void Scene::background() {
+    startFrame();
     system_background();
 }
 
 void act_on_state_change() {
-    current_scene->onStateChange(previous_state);
+    current_scene->onStateChange(model().previous_state);
 }
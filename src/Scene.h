@@ -6,6 +6,7 @@
 #include "GrblParserC.h"
 #include "Drawing.h"
 #include "NVS.h"
+#include "Timer.h"
 #include <vector>
 
 void pop_scene(void* arg = nullptr);
@@ -24,6 +25,14 @@ private:
     int _encoder_accum = 0;
     int _encoder_scale = 1;
 
+    uint32_t _drawn_seq = 0;  // Sequence number of the last model snapshot drawn
+
+    bool       _dirty            = false;
+    bool       _scheduled        = false;  // Set by frameDue() for the frame it starts
+    timer_id_t _frame_timer      = 0;      // From invalidateAfter()
+    int        _frames_requested = 0;
+    int        _frames_rendered  = 0;
+
 protected:
     const char** _help_text = nullptr;
 
@@ -76,9 +85,11 @@ public:
     virtual void onTouchFlick() {}
 
     virtual void onError(const char* errstr) {}
+    virtual void onAlarm() {}
 
     virtual void onStateChange(state_t) {}
-    virtual void onDROChange() {}
+    virtual void onDROChange(change_mask_t changes) {}  // changes says which status fields differ
+    virtual void onDROInterpolate() {}  // Time to redraw extrapolated DROs
     virtual void onLimitsChange() {}
     virtual void onMessage(char* command, char* arguments) {}
     virtual void onEncoder(int delta) {}
@@ -101,6 +112,31 @@ public:
     void getPref(const char* name, int axis, char* value, int maxlen);
 
     void background();
+
+    // Asks for a reDisplay() at the next frame time.  Any number of
+    // requests before then cost one frame.  Input handlers use this
+    // rather than drawing, so that they return within a millisecond.
+    void invalidate() {
+        _dirty = true;
+        ++_frames_requested;
+    }
+    // Like invalidate(), but for a frame ms from now, e.g. the next step
+    // of an animation.  Replaces any earlier such request.
+    void invalidateAfter(int ms);
+    bool dirty() { return _dirty; }
+    bool frameDue();  // True, and no longer dirty, if a frame should render now
+    void rendered();  // Called by refreshDisplay()
+
+    // Timers that are cancelled when the scene is exited
+    timer_id_t after(int ms, TimerHandler handler, void* arg = nullptr) { return set_timeout(ms, handler, arg, this); }
+    timer_id_t every(int ms, TimerHandler handler, void* arg = nullptr) { return set_interval(ms, handler, arg, this); }
+
+    // Returns the current model snapshot and remembers that it was drawn
+    const ModelSnapshot& snapshot() {
+        _drawn_seq = model().seq;
+        return model();
+    }
+    bool snapshotDrawn() { return model().seq == _drawn_seq; }
 };
 
 bool touchIsCenter();
@@ -135,6 +171,19 @@ void rotateNumberLoop(T& currentVal, T increment, T min, T max) {
 typedef void (*ActionHandler)(void);
 void schedule_action(ActionHandler action);
 
+// Parser callbacks post events instead of drawing from inside fnc_poll().
+// dispatch_events() delivers them once per loop iteration and merges
+// duplicates, so a burst of replies renders at most one frame.
+enum ui_event_t : uint8_t {
+    ModelChangedEvent  = 1 << 0,  // Modes, homing, wifi info, ...
+    ConfigArrivedEvent = 1 << 1,  // A ConfigItem got its value
+    ErrorEvent         = 1 << 2,  // lastError or an error message
+    AlarmEvent         = 1 << 3,  // lastAlarm
+    FilesListEvent     = 1 << 4,  // A file or macro list is complete
+};
+void post_event(ui_event_t event);
+void post_error(const char* errstr);  // Delivered via onError(); the latest message wins
+
 extern Scene* current_scene;
 
 void dispatch_events();
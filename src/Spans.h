@@ -0,0 +1,103 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Scanline geometry of rings and arcs.  The functions call
+// fill(dy, left, right) for each horizontal span that a shape covers,
+// as offsets from its center, with at most two spans per row.  Nothing
+// here draws, so the host tests can check the spans pixel by pixel.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Returns the half width at row offset dy of the pixels within radius
+// of the center, or -1 if the row misses them
+inline int disc_half_width(int radius, int dy) {
+    int d2 = radius * radius + radius - dy * dy;  // (radius + 1/2)^2, rounded down
+    return d2 < 0 ? -1 : (int)sqrtf(d2);
+}
+
+template <class Fill>
+inline void fill_span(Fill& fill, int dy, int left, int right) {
+    if (right >= left) {
+        fill(dy, left, right);
+    }
+}
+
+// Fills row dy of a ring whose outer and inner half widths there are xo
+// and xi, where xi < 0 means the row misses the hole
+template <class Fill>
+inline void ring_row(Fill& fill, int dy, int xo, int xi) {
+    if (xi < 0) {
+        fill_span(fill, dy, -xo, xo);
+    } else {
+        fill_span(fill, dy, -xo, -xi - 1);
+        fill_span(fill, dy, xi + 1, xo);
+    }
+}
+
+// The pixels within outer of the center and not within inner - 1
+template <class Fill>
+void ring_spans(int outer, int inner, Fill fill) {
+    // Rows above and below the center mirror each other
+    for (int dy = 0; dy <= outer; dy++) {
+        int xo = disc_half_width(outer, dy);
+        int xi = inner > 0 ? disc_half_width(inner - 1, dy) : -1;
+        ring_row(fill, dy, xo, xi);
+        if (dy) {
+            ring_row(fill, -dy, xo, xi);
+        }
+    }
+}
+
+// Limits [lo, hi] to the offsets dx with a * dx + b >= 0
+inline void clip_half_plane(float a, float b, float& lo, float& hi) {
+    if (a > 1e-6f) {
+        lo = std::max(lo, -b / a);
+    } else if (a < -1e-6f) {
+        hi = std::min(hi, -b / a);
+    } else if (b < 0) {
+        hi = lo - 1;
+    }
+}
+
+// The part of a ring from start_angle clockwise to end_angle, in degrees
+// clockwise from 3 o'clock as LovyanGFX measures them
+template <class Fill>
+void arc_spans(int outer, int inner, int start_angle, int end_angle, Fill fill) {
+    while (end_angle < start_angle) {
+        end_angle += 360;
+    }
+    // A sector is convex, so each row of it is one interval, only up to
+    // a half turn
+    if (end_angle - start_angle > 180) {
+        int middle = (start_angle + end_angle) / 2;
+        arc_spans(outer, inner, start_angle, middle, fill);
+        arc_spans(outer, inner, middle, end_angle, fill);
+        return;
+    }
+    float c0 = cosf(start_angle * (float)M_PI / 180);
+    float s0 = sinf(start_angle * (float)M_PI / 180);
+    float c1 = cosf(end_angle * (float)M_PI / 180);
+    float s1 = sinf(end_angle * (float)M_PI / 180);
+    for (int dy = -outer; dy <= outer; dy++) {
+        int xo = disc_half_width(outer, dy);
+        int xi = inner > 0 ? disc_half_width(inner - 1, dy) : -1;
+
+        // Clockwise of the start ray and counterclockwise of the end ray
+        float lo = -xo;
+        float hi = xo;
+        clip_half_plane(-s0, c0 * dy, lo, hi);
+        clip_half_plane(s1, -c1 * dy, lo, hi);
+        int left  = (int)ceilf(lo - 0.001f);
+        int right = (int)floorf(hi + 0.001f);
+
+        if (xi < 0) {
+            fill_span(fill, dy, left, right);
+        } else {
+            fill_span(fill, dy, left, std::min(right, -xi - 1));
+            fill_span(fill, dy, std::max(left, xi + 1), right);
+        }
+    }
+}
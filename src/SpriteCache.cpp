@@ -0,0 +1,64 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "SpriteCache.h"
+#include "Drawing.h"
+
+SpriteCache::SpriteCache(size_t budget, size_t psram_budget) : _budget(budget), _psram(false) {
+#ifdef ARDUINO
+    if (psramFound()) {
+        _psram  = true;
+        _budget = psram_budget;
+    }
+#endif
+}
+
+LGFX_Sprite* SpriteCache::find(const std::string& key) {
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    _lru.splice(_lru.begin(), _lru, it->second);
+    return it->second->sprite;
+}
+
+void SpriteCache::evict() {
+    entry_t& victim = _lru.back();
+    _used -= victim.bytes;
+    victim.sprite->deleteSprite();
+    delete victim.sprite;
+    _index.erase(victim.key);
+    _lru.pop_back();
+    ++evictions;
+}
+
+LGFX_Sprite* SpriteCache::create(const std::string& key, int width, int height) {
+    size_t bytes = width * height * (canvas.getColorDepth() & 0xff) / 8;  // Without the palette flag
+    if (bytes > _budget) {
+        return nullptr;
+    }
+    while (_used + bytes > _budget) {
+        evict();
+    }
+
+    LGFX_Sprite* sprite = new LGFX_Sprite(&canvas);
+    sprite->setColorDepth(canvas.getColorDepth());
+    sprite->setPsram(_psram);
+    if (!sprite->createSprite(width, height)) {
+        delete sprite;
+        return nullptr;
+    }
+    useThemePalette(sprite);
+    _lru.push_front(entry_t { key, sprite, bytes });
+    _index[key] = _lru.begin();
+    _used += bytes;
+    return sprite;
+}
+
+void SpriteCache::clear() {
+    while (!_lru.empty()) {
+        evict();
+    }
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// A least-recently-used cache of pre-rendered sprites, so that images
+// like menu icons are decoded once and then just blitted to the canvas.
+
+#pragma once
+
+#include "System.h"
+#include <list>
+#include <string>
+#include <unordered_map>
+
+class SpriteCache {
+private:
+    struct entry_t {
+        std::string  key;
+        LGFX_Sprite* sprite;
+        size_t       bytes;
+    };
+    std::list<entry_t>                                            _lru;  // Most recently used first
+    std::unordered_map<std::string, std::list<entry_t>::iterator> _index;
+
+    size_t _budget;
+    size_t _used = 0;
+    bool   _psram;
+
+    void evict();
+
+public:
+    // The budget is in bytes of sprite memory.  If PSRAM is present it
+    // holds the sprites and the larger budget applies.
+    SpriteCache(size_t budget, size_t psram_budget);
+
+    // Returns the sprite cached under key, or nullptr
+    LGFX_Sprite* find(const std::string& key);
+
+    // Makes an empty sprite under key, evicting the least recently used
+    // ones to stay within budget.  Returns nullptr if it cannot fit.
+    LGFX_Sprite* create(const std::string& key, int width, int height);
+
+    void clear();
+
+    int hits      = 0;
+    int misses    = 0;
+    int evictions = 0;
+};
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
 
 #include "Scene.h"
+#include "Widget.h"
 
 extern Scene menuScene;
 
@@ -18,13 +19,29 @@ private:
 
     ovrd_display_t overd_display = FRO;
 
+    WidgetGroup  _widgets { "Status" };
+    StatusPill   _status { "status" };
+    DROWidget    _dros[3] = { { "X", 0, 15, 68, 210, 32 }, { "Y", 1, 15, 101, 210, 32 }, { "Z", 2, 15, 134, 210, 32 } };
+    ProgressBar  _progress { "progress", 20, 170, 192, 10 };
+    Label        _legend { "legend", 0, 193, 240 };
+    LegendWidget _buttons { "buttons" };
+
 public:
-    StatusScene() : Scene("Status") {}
+    StatusScene() : Scene("Status") {
+        _widgets.add(&_status);
+        for (auto& dro : _dros) {
+            _widgets.add(&dro);
+        }
+        _widgets.add(&_progress);
+        _widgets.add(&_legend);
+        _widgets.add(&_buttons);
+    }
 
+    void onEntry(void* arg) override { _widgets.invalidate(); }
     void onExit() override {}
 
     void onDialButtonPress() {
-        if (state == Cycle || state == Hold) {
+        if (model().state == Cycle || model().state == Hold) {
             if (overd_display == FRO)
                 fnc_realtime(FeedOvrReset);
             else if (overd_display == SRO)
@@ -35,13 +52,13 @@ public:
     }
 
     void onStateChange(state_t old_state) {
-        if (old_state == Cycle && state == Idle && parent_scene() != &menuScene) {
+        if (old_state == Cycle && model().state == Idle && parent_scene() != &menuScene) {
             pop_scene();
         }
     }
 
     void onTouchClick() {
-        if (touchY > 150 && (state == Cycle || state == Hold)) {
+        if (touchY > 150 && (model().state == Cycle || model().state == Hold)) {
             switch (overd_display) {
                 case FRO:
                     overd_display = SRO;
@@ -52,13 +69,13 @@ public:
                 case RT_FEED_SPEED:
                     overd_display = FRO;
             }
-            reDisplay();
+            invalidate();
         }
         fnc_realtime(StatusReport);  // sometimes you want an extra status
     }
 
     void onRedButtonPress() {
-        switch (state) {
+        switch (model().state) {
             case Alarm:
                 if (alarm_is_critical()) {
                     // Critical alarm that must be hard-cleared with a CTRL-X reset
@@ -84,7 +101,7 @@ public:
         return lastAlarm == 1 || lastAlarm == 2 || lastAlarm == 10 || lastAlarm == 13;
     }
     void onGreenButtonPress() {
-        switch (state) {
+        switch (model().state) {
             case Cycle:
                 fnc_realtime(FeedHold);
                 break;
@@ -102,19 +119,19 @@ public:
     }
 
     void onEncoder(int delta) {
-        if (state == Cycle) {
+        if (model().state == Cycle) {
             switch (overd_display) {
                 case FRO:
-                    if (delta > 0 && myFro < 200) {
+                    if (delta > 0 && model().fro < 200) {
                         fnc_realtime(FeedOvrFinePlus);
-                    } else if (delta < 0 && myFro > 10) {
+                    } else if (delta < 0 && model().fro > 10) {
                         fnc_realtime(FeedOvrFineMinus);
                     }
                     break;
                 case SRO:
-                    if (delta > 0 && mySro < 200) {
+                    if (delta > 0 && model().sro < 200) {
                         fnc_realtime(SpindleOvrFinePlus);
-                    } else if (delta < 0 && mySro > 10) {
+                    } else if (delta < 0 && model().sro > 10) {
                         fnc_realtime(SpindleOvrFineMinus);
                     }
                     break;
@@ -122,49 +139,49 @@ public:
                     overd_display = FRO;
             }
 
-            reDisplay();
+            invalidate();
         }
     }
 
-    void onDROChange() { reDisplay(); }
+    void onDROChange(change_mask_t changes) override {
+        if (!snapshotDrawn() && (changes & (AxesChanged | OverridesChanged | FeedSpeedChanged | PercentChanged | StateNameChanged))) {
+            invalidate();
+        }
+    }
+    void onDROInterpolate() override { invalidate(); }
     void onLimitsChange() { reDisplay(); }
 
+    // Only the widgets whose values changed are repainted, unless the
+    // scene was just entered
     void reDisplay() {
-        background();
-        drawMenuTitle(current_scene->name());
-        drawStatus();
-
-        DRO dro(16, 68, 210, 32);
-        dro.draw(0, -1, true);
-        dro.draw(1, -1, true);
-        dro.draw(2, -1, true);
-
-        int y = 170;
-        if (state == Cycle || state == Hold) {
-            int width  = 192;
-            int height = 10;
-            if (myPercent > 0) {
-                drawRect(20, y, width, height, 5, LIGHTGREY);
-                width = (width * myPercent) / 100;
-                if (width > 0) {
-                    drawRect(20, y, width, height, 5, GREEN);
-                }
-            }
+        const ModelSnapshot& m = snapshot();
+
+        if (!_widgets.valid()) {
+            background();
+            drawMenuTitle(current_scene->name());
+        } else {
+            startFrame();  // background() does this for full frames
+        }
+
+        if (m.state == Cycle || m.state == Hold) {
+            _progress.set(m.percent > 0 ? m.percent : -1);
+
             // Feed override
             char legend[50];
             switch (overd_display) {
                 case FRO:
-                    sprintf(legend, "Feed Rate Ovr:%d%%", myFro);
+                    sprintf(legend, "Feed Rate Ovr:%d%%", m.fro);
                     break;
                 case SRO:
-                    sprintf(legend, "Spindle Ovr:%d%%", mySro);
+                    sprintf(legend, "Spindle Ovr:%d%%", m.sro);
                     break;
                 case RT_FEED_SPEED:
-                    sprintf(legend, "Fd:%d Spd:%d", myFeed, mySpeed);
+                    sprintf(legend, "Fd:%d Spd:%d", m.feed, m.speed);
             }
-            centered_text(legend, y + 23);
+            _legend.set(legend);
         } else {
-            centered_text(mode_string(), y + 23, GREEN, TINY);
+            _progress.set(-1);
+            _legend.set(mode_string(), GREEN);
         }
 
         const char* encoder_button_text = "Menu";
@@ -173,7 +190,7 @@ public:
         const char* redLabel    = "";
         const char* yellowLabel = "Back";
 
-        switch (state) {
+        switch (m.state) {
             case Alarm:
                 if (alarm_is_critical()) {
                     redLabel = "Reset";
@@ -204,9 +221,11 @@ public:
             case Idle:
                 break;
         }
-        drawButtonLegends(redLabel, grnLabel, yellowLabel);
+        _buttons.set(redLabel, grnLabel, yellowLabel);
 
-        refreshDisplay();
+        if (_widgets.update()) {
+            refreshDisplay();
+        }
     }
 };
 StatusScene statusScene;
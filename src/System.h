@@ -6,12 +6,13 @@
 #include "Config.h"
 #include "Encoder.h"
 
+constexpr static const int UPDATE_RATE_MS = 30;  // minimum refresh rate in milliseconds
+
 #ifdef ARDUINO
 #    include <Arduino.h>
 #    include <LittleFS.h>
-constexpr static const int UPDATE_RATE_MS = 30;  // minimum refresh rate in milliseconds
-extern Stream&             debugPort;
-void                       init_fnc_uart(int uart_num, int tx_pin, int rx_pin);
+extern Stream& debugPort;
+void           init_fnc_uart(int uart_num, int tx_pin, int rx_pin);
 #endif  // ARDUINO
 
 #ifdef USE_LOVYANGFX
@@ -31,18 +32,56 @@ void                       init_fnc_uart(int uart_num, int tx_pin, int rx_pin);
 #    define ORANGE TFT_ORANGE
 #    define BROWN TFT_BROWN
 #    define MAROON TFT_MAROON
+#    define MAGENTA TFT_MAGENTA
 #endif  // USE_LOVYANGFX
 
 #ifdef USE_M5
 #    include "M5Unified.h"
 #endif  // USE_M5
 
+#ifdef PALETTE_CANVAS
+// Colors are indices into the canvas palette, see theme_palette
+#    undef WHITE
+#    undef BLACK
+#    undef RED
+#    undef YELLOW
+#    undef BLUE
+#    undef LIGHTGREY
+#    undef DARKGREY
+#    undef GREEN
+#    undef NAVY
+#    undef CYAN
+#    undef ORANGE
+#    undef BROWN
+#    undef MAROON
+#    undef MAGENTA
+#    define BLACK 0
+// 1 is a second black, for NO_BG
+#    define WHITE 2
+#    define RED 3
+#    define YELLOW 4
+#    define BLUE 5
+#    define LIGHTGREY 6
+#    define DARKGREY 7
+#    define GREEN 8
+#    define NAVY 9
+#    define CYAN 10
+#    define ORANGE 11
+#    define BROWN 12
+#    define MAROON 13
+#    define MAGENTA 14
+#    define LIGHTYELLOW 15
+#else
+#    define LIGHTYELLOW 0xFFF0
+#endif  // PALETTE_CANVAS
+
 extern LGFX_Device&     display;
 extern LGFX_Sprite      canvas;
 extern m5::Touch_Class& touch;
 
 void drawPngFile(const char* filename, int x, int y);
 void drawPngFile(LGFX_Sprite* sprite, const char* filename, int x, int y);
+bool drawRawFile(LovyanGFX* dst, const char* filename, int x, int y);
 
 void init_system();
 
@@ -56,7 +95,8 @@ void dbg_println(const std::string& s);
 void dbg_printf(const char* format, ...);
 
 void update_events();
-void delay_ms(uint32_t ms);
+void delay_ms(uint32_t ms);  // Not for the UI path; use set_timeout() there
+int  microseconds();
 
 void resetFlowControl();
 
@@ -6,12 +6,16 @@
 #include "System.h"
 #include "FluidNCModel.h"
 #include "NVS.h"
+#include "Drawing.h"
 
 #include <Esp.h>  // ESP.restart()
 
 #include <driver/uart.h>
 #include "hal/uart_hal.h"
 
+#include <algorithm>
+#include <vector>
+
 uart_port_t fnc_uart_port;
 
 // We use the ESP-IDF UART driver instead of the Arduino
@@ -67,12 +71,124 @@ extern "C" void poll_extra() {
 void drawPngFile(const char* filename, int x, int y) {
     drawPngFile(&canvas, filename, x, y);
 }
+#ifdef PALETTE_CANVAS
+// Palette sprites take color indices, so the PNG is decoded a strip at a
+// time into an RGB565 sprite holding the colors already under it, and
+// each pixel is mapped to the nearest theme color
+static void drawPngIndexed(LGFX_Sprite* sprite, const char* path, int x, int y) {
+    const int   strip_h = 16;
+    int         width   = sprite->width();
+    int         height  = sprite->height();
+    LGFX_Sprite strip;
+    strip.setColorDepth(16);
+    if (!strip.createSprite(width, strip_h)) {
+        return;
+    }
+    for (int top = 0; top < height; top += strip_h) {
+        int rows = std::min(strip_h, height - top);
+        for (int j = 0; j < rows; j++) {
+            for (int i = 0; i < width; i++) {
+                strip.drawPixel(i, j, themeColor565(sprite->readPixelValue(i, top + j)));
+            }
+        }
+        // Centered in the whole sprite, as drawPngFile() does
+        strip.drawPngFile(LittleFS, path, x, (height - strip_h) / 2 - y - top, 0, 0, 0, 0, 1.0f, 1.0f, datum_t::middle_center);
+        for (int j = 0; j < rows; j++) {
+            for (int i = 0; i < width; i++) {
+                uint16_t c = strip.readPixel(i, j);
+                sprite->drawPixel(i, top + j, themeColor332((c >> 13) << 5 | ((c >> 8) & 7) << 2 | ((c >> 3) & 3)));
+            }
+        }
+    }
+}
+#endif
+
 void drawPngFile(LGFX_Sprite* sprite, const char* filename, int x, int y) {
-    // When datum is middle_center, the origin is the center of the canvas and the
-    // +Y direction is down.
+#ifdef SHOW_ASSET_TIMES
+    int start_ms = milliseconds();
+#endif
+    // Prefer the raw bitmap that the build made from the PNG
+    if (!drawRawFile(sprite, filename, x, y)) {
+        // When datum is middle_center, the origin is the center of the canvas and the
+        // +Y direction is down.
+        std::string fn { "/" };
+        fn += filename;
+#ifdef PALETTE_CANVAS
+        drawPngIndexed(sprite, fn.c_str(), x, y);
+#else
+        sprite->drawPngFile(LittleFS, fn.c_str(), x, -y, 0, 0, 0, 0, 1.0f, 1.0f, datum_t::middle_center);
+#endif
+    }
+#ifdef SHOW_ASSET_TIMES
+    dbg_printf("%s: %d ms\n", filename, milliseconds() - start_ms);
+#endif
+}
+
+// Draws the .r8 file that convert_assets.py made from a PNG, centered
+// like drawPngFile().  Returns false if there is no such file.
+bool drawRawFile(LovyanGFX* dst, const char* filename, int x, int y) {
     std::string fn { "/" };
     fn += filename;
-    sprite->drawPngFile(LittleFS, fn.c_str(), x, -y, 0, 0, 0, 0, 1.0f, 1.0f, datum_t::middle_center);
+    if (fn.length() > 4 && fn.compare(fn.length() - 4, 4, ".png") == 0) {
+        fn.resize(fn.length() - 4);
+    }
+    fn += ".r8";
+    if (!LittleFS.exists(fn.c_str())) {
+        return false;
+    }
+    File file = LittleFS.open(fn.c_str(), "r");
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> data(file.size());
+    size_t               len = file.read(data.data(), data.size());
+    file.close();
+    if (len < 8 || data[0] != 'R' || data[1] != '8') {
+        return false;
+    }
+
+    bool    rle         = data[2] & 1;
+    bool    transparent = data[2] & 2;
+    uint8_t key         = data[3];
+    int     w           = data[4] | data[5] << 8;
+    int     h           = data[6] | data[7] << 8;
+    int     left        = (dst->width() - w) / 2 + x;
+    int     top         = (dst->height() - h) / 2 - y;
+
+    std::vector<uint8_t> line(w);
+    const uint8_t*       p   = data.data() + 8;
+    const uint8_t*       end = data.data() + len;
+    for (int row = 0; row < h; row++) {
+        if (rle) {
+            for (int i = 0; i < w && p + 2 <= end; p += 2) {
+                int n = std::min<int>(p[0], w - i);
+                memset(&line[i], p[1], n);
+                i += n;
+            }
+        } else if (p + w <= end) {
+            memcpy(line.data(), p, w);
+            p += w;
+        }
+#ifdef PALETTE_CANVAS
+        // Sprites take color indices, so draw each run in its nearest
+        // theme color; the display takes RGB as usual
+        if (dst != &display) {
+            for (int i = 0, n; i < w; i += n) {
+                for (n = 1; i + n < w && line[i + n] == line[i]; n++) {}
+                if (!transparent || line[i] != key) {
+                    dst->drawFastHLine(left + i, top + row, n, themeColor332(line[i]));
+                }
+            }
+            continue;
+        }
+#endif
+        if (transparent) {
+            dst->pushImage(left, top + row, w, 1, (const lgfx::rgb332_t*)line.data(), key);
+        } else {
+            dst->pushImage(left, top + row, w, 1, (const lgfx::rgb332_t*)line.data());
+        }
+    }
+    return true;
 }
 
 #define FORMAT_LITTLEFS_IF_FAILED true
@@ -124,8 +240,14 @@ void init_system() {
     }
 
     // Make an offscreen canvas that can be copied to the screen all at once
+#ifdef PALETTE_CANVAS
+    canvas.setColorDepth(4);
+#else
     canvas.setColorDepth(8);
+#endif
     canvas.createSprite(240, 240);  // display.width(), display.height());
+    useThemePalette(&canvas);
+    dbg_printf("Canvas: %d bytes, %d bytes free\n", canvas.bufferLength(), ESP.getFreeHeap());
 }
 void resetFlowControl() {
     fnc_putchar(0x11);
@@ -136,6 +258,10 @@ extern "C" int milliseconds() {
     return millis();
 }
 
+int microseconds() {
+    return micros();
+}
+
 void delay_ms(uint32_t ms) {
     delay(ms);
 }
@@ -41,6 +41,10 @@ extern "C" int milliseconds() {
     return m5gfx::millis();
 }
 
+int microseconds() {
+    return m5gfx::micros();
+}
+
 void delay_ms(uint32_t ms) {
     SDL_Delay(ms);
 }
@@ -48,6 +52,10 @@ void delay_ms(uint32_t ms) {
 void drawPngFile(const char* filename, int x, int y) {
     drawPngFile(&canvas, filename, x, y);
 }
+// The simulator reads data/ directly, which has no converted assets
+bool drawRawFile(LovyanGFX* dst, const char* filename, int x, int y) {
+    return false;
+}
 void drawPngFile(LGFX_Sprite* sprite, const char* filename, int x, int y) {
     std::string fn("data/");
     fn += filename;
@@ -281,6 +289,7 @@ Point sprite_offset { 0, 0 };
 void show_logo() {}
 void base_display() {
     display.clear();
+    invalidateDisplay();
 }
 
 void next_layout(int delta) {}
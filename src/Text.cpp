@@ -2,7 +2,10 @@
 // Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
 
 #include "Text.h"
+#include "GrblParserC.h"
+#include "SpriteCache.h"
 #include <map>
+#include <vector>
 
 const GFXfont* font[] = {
     // lgfx::v1::IFont* font[] = {
@@ -13,11 +16,14 @@ const GFXfont* font[] = {
     &fonts::FreeMonoBold18pt7b,  // MEDIUM_MONO
 };
 
+void text(LGFX_Sprite* sprite, const char* msg, int x, int y, int color, fontnum_t fontnum, int datum) {
+    sprite->setFont(font[fontnum]);
+    sprite->setTextDatum(datum);
+    sprite->setTextColor(color);
+    sprite->drawString(msg, x, y);
+}
 void text(const char* msg, int x, int y, int color, fontnum_t fontnum, int datum) {
-    canvas.setFont(font[fontnum]);
-    canvas.setTextDatum(datum);
-    canvas.setTextColor(color);
-    canvas.drawString(msg, x, y);
+    text(&canvas, msg, x, y, color, fontnum, datum);
 }
 void text(const std::string& msg, int x, int y, int color, fontnum_t fontnum, int datum) {
     text(msg.c_str(), x, y, color, fontnum, datum);
@@ -31,49 +37,225 @@ void text(const std::string& msg, Point xy, int color, fontnum_t fontnum, int da
     text(msg.c_str(), xy, color, fontnum, datum);
 }
 
+int text_width(const char* msg, fontnum_t fontnum) {
+    return canvas.textWidth(msg, font[fontnum]);
+}
+int font_height(fontnum_t fontnum) {
+    return canvas.fontHeight(font[fontnum]);
+}
+
 void centered_text(const char* msg, int y, int color, fontnum_t fontnum) {
     //    text(msg, display_short_side() / 2, y, color, fontnum);
     text(msg, canvas.width() / 2, y, color, fontnum);
 }
 
-void auto_text(const std::string& txt, int x, int y, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
-    bool doesnotfit = true;
-    while (true) {  // forever loop
-        int f = fontnum;
-        if (canvas.textWidth(txt.c_str(), font[fontnum]) <= w) {
-            doesnotfit = false;
+// Labels are rasterized once into small sprites and then blitted
+static SpriteCache label_cache(16 * 1024, 64 * 1024);
+static int         label_report_ms = 0;
+static int         label_hits      = 0;
+
+// Sets ax,ay to the point of a w x h box that datum refers to.  Returns
+// false for datums, like the baselines, that are not on the box.
+static bool datum_anchor(int datum, int w, int h, int& ax, int& ay) {
+    switch (datum) {
+        case top_left:
+        case middle_left:
+        case bottom_left:
+            ax = 0;
             break;
-        }
-        if (fontnum && tryfonts) {
-            fontnum = (fontnum_t)(--f);
-        } else {
+        case top_center:
+        case middle_center:
+        case bottom_center:
+            ax = w / 2;
+            break;
+        case top_right:
+        case middle_right:
+        case bottom_right:
+            ax = w;
+            break;
+        default:
+            return false;
+    }
+    switch (datum) {
+        case top_left:
+        case top_center:
+        case top_right:
+            ay = 0;
+            break;
+        case middle_left:
+        case middle_center:
+        case middle_right:
+            ay = h / 2;
             break;
+        default:
+            ay = h;
+            break;
+    }
+    return true;
+}
+
+void label(const char* msg, int x, int y, int color, fontnum_t fontnum, int datum) {
+    const int pad = 2;  // Room for glyphs that overhang the text box
+    int       w   = text_width(msg, fontnum);
+    int       h   = font_height(fontnum);
+    int       ax, ay;
+    if (!*msg || !datum_anchor(datum, w, h, ax, ay)) {
+        text(msg, x, y, color, fontnum, datum);
+        return;
+    }
+
+    // The sprite holds only the text color and this one
+    int transparent = color == MAGENTA ? BLACK : MAGENTA;
+
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "%d:%d:%d:", fontnum, color, datum);
+    std::string  key    = std::string(prefix) + msg;
+    LGFX_Sprite* sprite = label_cache.find(key);
+    if (!sprite) {
+        sprite = label_cache.create(key, w + 2 * pad, h + 2 * pad);
+        if (!sprite) {
+            text(msg, x, y, color, fontnum, datum);
+            return;
         }
+        sprite->fillSprite(transparent);
+        text(sprite, msg, pad + ax, pad + ay, color, fontnum, datum);
     }
+    sprite->pushSprite(&canvas, x - pad - ax, y - pad - ay, transparent);
+
+    int now = milliseconds();
+    if (now - label_report_ms >= 10000) {
+        int saved = label_cache.hits - label_hits;
+        if (saved) {
+            dbg_printf("Labels: %d rasterizations saved per second, %d misses, %d evictions\n",
+                       saved * 1000 / (now - label_report_ms),
+                       label_cache.misses,
+                       label_cache.evictions);
+        }
+        label_report_ms = now;
+        label_hits      = label_cache.hits;
+    }
+}
+void centered_label(const char* msg, int y, int color, fontnum_t fontnum) {
+    label(msg, canvas.width() / 2, y, color, fontnum);
+}
+
+// auto_text() remembers the font and cut point it chose for recent
+// strings, since menus redraw the same names on every scroll step
+struct fit_t {
+    uint32_t  hash;
+    uint16_t  len;
+    int16_t   w;
+    uint8_t   request;  // Requested font and flags
+    fontnum_t fontnum;  // Chosen font
+    int16_t   keep;     // Characters kept, or -1 if the text fits
+    bool      dots;
+};
+static fit_t fits[16];
+static int   next_fit = 0;
 
-    std::string s(txt);
+static uint32_t text_hash(const std::string& txt) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (char c : txt) {
+        hash = (hash ^ (uint8_t)c) * 16777619u;
+    }
+    return hash;
+}
 
-    if (doesnotfit) {
-        int dotswidth = canvas.textWidth(" ...");
+// Chooses the font and, if it still does not fit, how many characters
+// to keep from the start (or end if trimleft) before adding " ..."
+static fit_t fit_text(const std::string& txt, int w, fontnum_t fontnum, bool tryfonts, bool trimleft) {
+    fit_t fit;
+    fit.hash    = text_hash(txt);
+    fit.len     = txt.length();
+    fit.w       = w;
+    fit.request = fontnum << 2 | tryfonts << 1 | trimleft;
+    for (auto& f : fits) {
+        if (f.hash == fit.hash && f.len == fit.len && f.w == fit.w && f.request == fit.request) {
+            return f;
+        }
+    }
 
-        while (s.length() > 4) {
-            if (trimleft) {
-                s.erase(0, 1);
+    fit.keep = -1;
+    fit.dots = false;
+    while (canvas.textWidth(txt.c_str(), font[fontnum]) > w) {
+        if (fontnum && tryfonts) {
+            fontnum = (fontnum_t)(fontnum - 1);
+            continue;
+        }
+        // Cumulative advances give the width of every prefix or suffix,
+        // so the longest one that fits is a binary search away
+        size_t           n = txt.length();
+        std::vector<int> widths(n + 1, 0);
+        char             glyph[2] = { '\0', '\0' };
+        for (size_t i = 0; i < n; i++) {
+            glyph[0]      = trimleft ? txt[n - 1 - i] : txt[i];
+            widths[i + 1] = widths[i] + canvas.textWidth(glyph, font[fontnum]);
+        }
+        int dotswidth = canvas.textWidth(" ...", font[fontnum]);
+        int lo        = 4;  // Like before, never cut below 4 characters
+        int hi        = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (widths[mid] + dotswidth <= w) {
+                lo = mid;
             } else {
-                s.erase(s.length() - 1);
-            }
-            if (canvas.textWidth(s.c_str()) + dotswidth <= w) {
-                if (trimleft) {
-                    s.insert(0, "... ");
-                } else {
-                    s += " ...";
-                }
-                break;
+                hi = mid - 1;
             }
         }
+        if (lo <= hi) {
+            fit.keep = lo;
+            fit.dots = widths[lo] + dotswidth <= w;
+        }
+        break;
     }
+    fit.fontnum = fontnum;
 
-    text(s, x, y, color, fontnum, datum);
+    fits[next_fit] = fit;
+    next_fit       = (next_fit + 1) % 16;
+    return fit;
+}
+
+// The part of txt that fit_text() chose to show
+static std::string fitted_text(const std::string& txt, const fit_t& fit, bool trimleft) {
+    std::string s;
+    if (trimleft) {
+        s = txt.substr(txt.length() - fit.keep);
+        if (fit.dots) {
+            s.insert(0, "... ");
+        }
+    } else {
+        s = txt.substr(0, fit.keep);
+        if (fit.dots) {
+            s += " ...";
+        }
+    }
+    return s;
+}
+
+void auto_text(const std::string& txt, int x, int y, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
+    fit_t fit = fit_text(txt, w, fontnum, tryfonts, trimleft);
+    if (fit.keep < 0) {
+        text(txt, x, y, color, fit.fontnum, datum);
+        return;
+    }
+    text(fitted_text(txt, fit, trimleft), x, y, color, fit.fontnum, datum);
+}
+void auto_text(LGFX_Sprite*       sprite,
+               const std::string& txt,
+               int                x,
+               int                y,
+               int                w,
+               int                color,
+               fontnum_t          fontnum,
+               int                datum,
+               bool               tryfonts,
+               bool               trimleft) {
+    fit_t fit = fit_text(txt, w, fontnum, tryfonts, trimleft);
+    if (fit.keep < 0) {
+        text(sprite, txt.c_str(), x, y, color, fit.fontnum, datum);
+        return;
+    }
+    text(sprite, fitted_text(txt, fit, trimleft).c_str(), x, y, color, fit.fontnum, datum);
 }
 void auto_text(const std::string& txt, Point xy, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
     Point dispxy = xy.to_display();
@@ -42,3 +42,23 @@ void text(const char* msg, Point xy, int color, fontnum_t fontnum = TINY, int da
 void text(const std::string& msg, Point xy, int color, fontnum_t fontnum = TINY, int datum = middle_center);
 
 void centered_text(const char* msg, int y, int color = WHITE, fontnum_t fontnum = TINY);
+
+// Like text() and centered_text(), but the rendered string is cached, for
+// legends and titles that are drawn the same way on many frames
+void label(const char* msg, int x, int y, int color, fontnum_t fontnum = TINY, int datum = middle_center);
+void centered_label(const char* msg, int y, int color = WHITE, fontnum_t fontnum = TINY);
+
+// Variants that draw into, or measure for, an offscreen sprite instead of the canvas
+void text(LGFX_Sprite* sprite, const char* msg, int x, int y, int color, fontnum_t fontnum = TINY, int datum = middle_center);
+void auto_text(LGFX_Sprite*       sprite,
+               const std::string& txt,
+               int                x,
+               int                y,
+               int                w,
+               int                color,
+               fontnum_t          fontnum  = MEDIUM,
+               int                datum    = middle_center,
+               bool               tryfonts = true,
+               bool               trimleft = false);
+int  text_width(const char* msg, fontnum_t fontnum);
+int  font_height(fontnum_t fontnum);
@@ -0,0 +1,184 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Timer.h"
+#include "System.h"
+#include "GrblParserC.h"  // milliseconds()
+
+// A hashed timing wheel.  Each slot holds the timers due in one tick,
+// or in that tick of a later turn of the wheel, so run_timers() only
+// looks at the slots for the ticks that passed since its last call.
+static const int tick_ms     = 10;
+static const int wheel_slots = 32;
+static const int max_timers  = 16;
+
+struct timer_entry_t {
+    timer_id_t   id;  // 0 if free
+    int          due_ms;
+    int          period_ms;  // 0 for one-shot
+    TimerHandler handler;
+    void*        arg;
+    Scene*       owner;
+    int8_t       next;  // Next timer in the same slot, or -1
+};
+
+static timer_entry_t timers[max_timers];
+static int8_t        wheel[wheel_slots];
+static bool          wheel_ready = false;
+static int           last_tick;
+static timer_id_t    next_id = 1;
+
+static int slot_of(int due_ms) {
+    return (unsigned)(due_ms / tick_ms) % wheel_slots;
+}
+
+static void init_wheel() {
+    for (auto& head : wheel) {
+        head = -1;
+    }
+    last_tick   = milliseconds() / tick_ms;
+    wheel_ready = true;
+}
+
+static void link(int i) {
+    int slot       = slot_of(timers[i].due_ms);
+    timers[i].next = wheel[slot];
+    wheel[slot]    = i;
+}
+
+// Does nothing if the timer is not on the wheel because it is being run
+static void unlink(int i) {
+    for (int8_t* p = &wheel[slot_of(timers[i].due_ms)]; *p != -1; p = &timers[*p].next) {
+        if (*p == i) {
+            *p = timers[i].next;
+            return;
+        }
+    }
+}
+
+static timer_id_t add_timer(int ms, int period_ms, TimerHandler handler, void* arg, Scene* owner) {
+    if (!wheel_ready) {
+        init_wheel();
+    }
+    for (int i = 0; i < max_timers; i++) {
+        timer_entry_t& t = timers[i];
+        if (t.id == 0) {
+            t.id = next_id++;
+            if (next_id <= 0) {
+                next_id = 1;
+            }
+            t.due_ms    = milliseconds() + (ms > 0 ? ms : 0);
+            t.period_ms = period_ms;
+            t.handler   = handler;
+            t.arg       = arg;
+            t.owner     = owner;
+            link(i);
+            return t.id;
+        }
+    }
+    dbg_println("Out of timers");
+    return 0;
+}
+
+timer_id_t set_timeout(int ms, TimerHandler handler, void* arg, Scene* owner) {
+    return add_timer(ms, 0, handler, arg, owner);
+}
+timer_id_t set_interval(int ms, TimerHandler handler, void* arg, Scene* owner) {
+    return add_timer(ms, ms > 0 ? ms : 1, handler, arg, owner);
+}
+
+void cancel_timer(timer_id_t id) {
+    if (id == 0) {
+        return;
+    }
+    for (int i = 0; i < max_timers; i++) {
+        if (timers[i].id == id) {
+            unlink(i);
+            timers[i].id = 0;
+            return;
+        }
+    }
+}
+void cancel_timers(Scene* owner) {
+    for (int i = 0; i < max_timers; i++) {
+        if (timers[i].id && timers[i].owner == owner) {
+            unlink(i);
+            timers[i].id = 0;
+        }
+    }
+}
+
+void run_timers() {
+    if (!wheel_ready) {
+        return;
+    }
+    int now  = milliseconds();
+    int tick = now / tick_ms;
+
+    // The slot of last_tick is looked at again because timers set since
+    // then can be due later in the same tick
+    int ticks = tick - last_tick + 1;
+    if (ticks > wheel_slots) {
+        ticks = wheel_slots;
+    }
+    int first = tick - ticks + 1;
+    last_tick = tick;
+
+    // Take the due timers off the wheel before calling any handler,
+    // since handlers can set and cancel timers
+    int8_t     due[max_timers];
+    timer_id_t due_ids[max_timers];
+    int        ndue = 0;
+    for (int t = first; t <= tick; t++) {
+        int8_t* p = &wheel[(unsigned)t % wheel_slots];
+        while (*p != -1) {
+            int i = *p;
+            if (now - timers[i].due_ms >= 0) {
+                *p            = timers[i].next;
+                due[ndue]     = i;
+                due_ids[ndue] = timers[i].id;
+                ndue++;
+            } else {
+                p = &timers[i].next;
+            }
+        }
+    }
+
+    for (int n = 0; n < ndue; n++) {
+        timer_entry_t& t = timers[due[n]];
+        if (t.id != due_ids[n]) {
+            continue;  // Cancelled by an earlier handler
+        }
+        TimerHandler handler = t.handler;
+        void*        arg     = t.arg;
+        if (t.period_ms) {
+            t.due_ms += t.period_ms;
+            if (now - t.due_ms >= 0) {
+                t.due_ms = now + t.period_ms;
+            }
+            link(due[n]);
+        } else {
+            t.id = 0;
+        }
+        handler(arg);
+    }
+}
+
+void Tween::start(int from, int to, int duration_ms) {
+    _from        = from;
+    _to          = to;
+    _start_ms    = milliseconds();
+    _duration_ms = duration_ms;
+}
+int Tween::value() {
+    int elapsed = milliseconds() - _start_ms;
+    if (!_duration_ms || elapsed >= _duration_ms) {
+        return _to;
+    }
+    // Quadratic ease-out: fast at first, slowing to a stop
+    int left = 1024 - elapsed * 1024 / _duration_ms;  // 1024ths of the time left
+    return _to - (int)((int64_t)(_to - _from) * left * left / (1024 * 1024));
+}
+bool Tween::running() {
+    return _duration_ms && milliseconds() - _start_ms < _duration_ms;
+}
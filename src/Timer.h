@@ -0,0 +1,43 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// One-shot and periodic callbacks that run from dispatch_events(), on
+// the main loop between input events and frames.  Code in the UI path
+// must not wait; it schedules the rest of its work here instead.
+
+#pragma once
+
+class Scene;
+
+typedef int timer_id_t;  // 0 is never a valid timer
+typedef void (*TimerHandler)(void* arg);
+
+// Calls handler(arg) once, ms from now.  If owner is given, the timer
+// is cancelled when owner stops being the current scene.
+timer_id_t set_timeout(int ms, TimerHandler handler, void* arg = nullptr, Scene* owner = nullptr);
+// Calls handler(arg) every ms until cancelled.  Periods that a busy
+// loop misses are skipped, not made up.
+timer_id_t set_interval(int ms, TimerHandler handler, void* arg = nullptr, Scene* owner = nullptr);
+
+// Safe to call with 0, with an expired timer, or from the timer's handler
+void cancel_timer(timer_id_t id);
+void cancel_timers(Scene* owner);
+
+// Runs the handlers that are due
+void run_timers();
+
+// A value that eases out from one number to another over a time.  An
+// animation draws value() on each frame while running(), so frames that
+// come late jump ahead instead of slowing the animation down.
+class Tween {
+private:
+    int _from        = 0;
+    int _to          = 0;
+    int _start_ms    = 0;
+    int _duration_ms = 0;
+
+public:
+    void start(int from, int to, int duration_ms);
+    int  value();
+    bool running();
+};
@@ -25,11 +25,11 @@ public:
     void onDialButtonPress() { pop_scene(); }
 
     void onRedButtonPress() {
-        if (state == Idle) {
-        } else if (state == Cycle) {
+        if (model().state == Idle) {
+        } else if (model().state == Cycle) {
         }
 
-        switch (state) {
+        switch (model().state) {
             case Idle:
                 send_linef("T%d", _new_tool);
                 break;
@@ -45,7 +45,7 @@ public:
     }
 
     void onGreenButtonPress() {
-        switch (state) {
+        switch (model().state) {
             case Idle:
                 send_line("M6");
                 break;
@@ -66,7 +66,7 @@ public:
     void onStateChange(state_t old_state) { reDisplay(); }
 
     void onTouchClick() {
-        if (state == Idle) {
+        if (model().state == Idle) {
             send_linef("M61Q%d", _new_tool);
         }
     }
@@ -74,7 +74,7 @@ public:
     void onEncoder(int delta) {
         if (abs(delta) > 0) {
             rotateNumberLoop(_new_tool, delta, 0, 255);
-            reDisplay();
+            invalidate();
         }
     }
     void onEntry(void* arg) override {}
@@ -96,7 +96,7 @@ public:
         sprintf(buffer, "Current T Value: %d", mySelectedTool);
         centered_text(buffer, y, LIGHTGREY, TINY);
 
-        switch (state) {
+        switch (model().state) {
             case Idle:
                 grnLabel = "M6";
                 redLabel = "T";
@@ -0,0 +1,157 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Widget.h"
+
+bool Widget::update() {
+    if (!_placed) {
+        place();
+        _placed = true;
+    }
+    bool different = changed();  // Always called, so the remembered value stays current
+    if (_valid && !different) {
+        return false;
+    }
+    if (_valid) {
+        repaintChanges();
+    } else {
+        repaint();
+    }
+    _valid = true;
+    ++repaints;
+    return true;
+}
+
+void Widget::repaint() {
+    restoreBackground(_x, _y, _w, _h);
+    paint();
+}
+
+bool WidgetGroup::update() {
+    if (!_valid) {
+        for (auto const& widget : _widgets) {
+            widget->invalidate();
+        }
+        _valid = true;
+    }
+    bool painted = false;
+    for (auto const& widget : _widgets) {
+        painted |= widget->update();
+    }
+    if (++_updates % 200 == 0) {
+        for (auto const& widget : _widgets) {
+            dbg_printf("%s %s: %d repaints in %d updates\n", _name, widget->name(), widget->repaints, _updates);
+        }
+    }
+    return painted;
+}
+
+bool Label::changed() {
+    if (_text == _shown && _color == _shown_color) {
+        return false;
+    }
+    _shown       = _text;
+    _shown_color = _color;
+    return true;
+}
+void Label::paint() {
+    text(_shown, _x + _w / 2, _middle, _shown_color, _font);
+}
+void Label::place() {
+    const int pad = 2;  // As label() allows for overhanging glyphs
+    _h            = font_height(_font) + 2 * pad;
+    _y            = _middle - _h / 2;
+}
+
+bool ProgressBar::changed() {
+    if (_percent == _shown) {
+        return false;
+    }
+    _shown = _percent;
+    return true;
+}
+void ProgressBar::paint() {
+    if (_shown < 0) {
+        return;
+    }
+    drawRect(_x, _y, _w, _h, _h / 2, LIGHTGREY);
+    int width = (_w * _shown) / 100;
+    if (width > 0) {
+        drawRect(_x, _y, width, _h, _h / 2, GREEN);
+    }
+}
+
+bool StatusPill::changed() {
+    const ModelSnapshot& m = model();
+    if (!_first && m.state == _state && m.state_string == _state_name && lastAlarm == _alarm) {
+        return false;
+    }
+    _first      = false;
+    _state      = m.state;
+    _state_name = m.state_string;
+    _alarm      = lastAlarm;
+    return true;
+}
+void StatusPill::paint() {
+    drawStatus();
+}
+
+bool DROWidget::changed() {
+    pos_t position = dro_position(_axis);
+    int   digits   = num_digits();
+    if (position == _shown && digits == _shown_digits && _hl_digit == _shown_hl && _highlight == _shown_highlight) {
+        return false;
+    }
+    _relabel         = _highlight != _shown_highlight;
+    _shown           = position;
+    _shown_digits    = digits;
+    _shown_hl        = _hl_digit;
+    _shown_highlight = _highlight;
+    return true;
+}
+void DROWidget::paint() {
+    _cells.count = 0;
+    DRO dro(_x, _y, _w, _h);
+    dro.draw(_axis, _shown_hl, _shown_highlight, _cells);
+}
+void DROWidget::repaintChanges() {
+    if (_relabel) {
+        repaint();
+        return;
+    }
+    DRO dro(_x, _y, _w, _h);
+    dro.draw(_axis, _shown_hl, _shown_highlight, _cells);
+}
+
+bool LegendWidget::changed() {
+    std::string legends = std::string(_red) + '\n' + _green + '\n' + _orange;
+    if (legends == _shown) {
+        return false;
+    }
+    _shown = legends;
+    return true;
+}
+void LegendWidget::paint() {
+    drawButtonLegends(_red, _green, _orange);
+}
+void LegendWidget::place() {
+    int bottom;
+    buttonLegendRows(_y, bottom);
+    _h = bottom - _y;
+    _w = canvas.width();
+}
+
+bool StripeWidget::changed() {
+    if (!_first && _left == _shown_left && _right == _shown_right && _highlighted == _shown_highlighted) {
+        return false;
+    }
+    _first             = false;
+    _shown_left        = _left;
+    _shown_right       = _right;
+    _shown_highlighted = _highlighted;
+    return true;
+}
+void StripeWidget::paint() {
+    Stripe stripe(_x, _y, _w, _h, _font);
+    stripe.draw(_shown_left.c_str(), _shown_right.c_str(), _shown_highlighted);
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Retained-mode pieces of a scene.  Each widget remembers the value it
+// last drew and its bounds on the canvas, and repaints only that area
+// when its value changes.  Scenes can move to widgets one part at a
+// time; anything not in a widget is drawn only on a full redraw.
+
+#pragma once
+
+#include "Drawing.h"
+#include <string>
+#include <vector>
+
+class Widget {
+private:
+    const char* _name;
+    bool        _valid  = false;
+    bool        _placed = false;
+
+protected:
+    int _x;
+    int _y;
+    int _w;
+    int _h;
+
+    // Returns true if the value to show differs from the one last
+    // painted, and remembers it
+    virtual bool changed() = 0;
+    virtual void paint()   = 0;
+    // Sets bounds that depend on font metrics, which can only be read
+    // once the display is up.  Called before the first paint.
+    virtual void place() {}
+
+    // Restores the scene background in the bounds and paints
+    void repaint();
+    // Called instead of repaint() when only the value changed, for
+    // widgets that can redraw just the parts that differ
+    virtual void repaintChanges() { repaint(); }
+
+public:
+    Widget(const char* name, int x, int y, int w, int h) : _name(name), _x(x), _y(y), _w(w), _h(h) {}
+
+    const char* name() { return _name; }
+    void        invalidate() { _valid = false; }
+
+    // Repaints if the value changed or the widget was invalidated.
+    // Returns true if the canvas changed.
+    bool update();
+
+    int repaints = 0;
+};
+
+class WidgetGroup {
+private:
+    const char*          _name;
+    std::vector<Widget*> _widgets;
+    bool                 _valid   = false;
+    int                  _updates = 0;
+
+public:
+    WidgetGroup(const char* name) : _name(name) {}
+
+    void add(Widget* widget) { _widgets.push_back(widget); }
+
+    // After invalidate(), the scene redraws its static parts and every
+    // widget repaints on the next update()
+    void invalidate() { _valid = false; }
+    bool valid() { return _valid; }
+
+    bool update();  // True if any widget repainted
+};
+
+// Text that is centered at (x + w/2, y), in bounds as tall as the font
+class Label : public Widget {
+private:
+    std::string _text;
+    int         _color = WHITE;
+    fontnum_t   _font;
+    int         _middle;
+    std::string _shown;
+    int         _shown_color = -1;
+
+    bool changed() override;
+    void paint() override;
+    void place() override;
+
+public:
+    Label(const char* name, int x, int y, int w, fontnum_t font = TINY) : Widget(name, x, y, w, 0), _font(font), _middle(y) {}
+    void set(const char* text, int color = WHITE) {
+        _text  = text;
+        _color = color;
+    }
+};
+
+// A rounded bar filled to a percentage, hidden when the percentage is negative
+class ProgressBar : public Widget {
+private:
+    int _percent = -1;
+    int _shown   = -2;
+
+    bool changed() override;
+    void paint() override;
+
+public:
+    ProgressBar(const char* name, int x, int y, int w, int h) : Widget(name, x, y, w, h) {}
+    void set(int percent) { _percent = percent; }
+};
+
+// The state pill drawn by drawStatus()
+class StatusPill : public Widget {
+private:
+    state_t     _state      = Disconnected;
+    const char* _state_name = nullptr;
+    int         _alarm      = 0;
+    bool        _first      = true;
+
+    bool changed() override;
+    void paint() override;
+
+public:
+    StatusPill(const char* name) : Widget(name, 50, 24, 140, 36) {}
+};
+
+// One DRO row, showing the current position of an axis
+class DROWidget : public Widget {
+private:
+    int         _axis;
+    int         _hl_digit        = -1;
+    bool        _highlight       = true;
+    pos_t       _shown           = 0;
+    int         _shown_digits    = -1;
+    int         _shown_hl        = -1;
+    bool        _shown_highlight = false;
+    bool        _relabel         = true;
+    NumberCells _cells;
+
+    bool changed() override;
+    void paint() override;
+    void repaintChanges() override;
+
+public:
+    DROWidget(const char* name, int axis, int x, int y, int w, int h) : Widget(name, x, y, w, h), _axis(axis) {}
+    void set(int hl_digit, bool highlight) {
+        _hl_digit  = hl_digit;
+        _highlight = highlight;
+    }
+};
+
+// The red, green and dial button legends along the bottom
+class LegendWidget : public Widget {
+private:
+    const char* _red    = "";
+    const char* _green  = "";
+    const char* _orange = "";
+    std::string _shown;
+
+    bool changed() override;
+    void paint() override;
+    void place() override;
+
+public:
+    LegendWidget(const char* name) : Widget(name, 0, 0, 0, 0) {}
+    void set(const char* red, const char* green, const char* orange) {
+        _red    = red;
+        _green  = green;
+        _orange = orange;
+    }
+};
+
+// A Stripe with a name on the left and a value on the right
+class StripeWidget : public Widget {
+private:
+    fontnum_t   _font;
+    std::string _left;
+    std::string _right;
+    bool        _highlighted       = false;
+    std::string _shown_left;
+    std::string _shown_right;
+    bool        _shown_highlighted = false;
+    bool        _first             = true;
+
+    bool changed() override;
+    void paint() override;
+
+public:
+    StripeWidget(const char* name, int x, int y, int w, int h, fontnum_t font = TINY) : Widget(name, x, y, w, h), _font(font) {}
+    void set(const char* left, const char* right, bool highlighted) {
+        _left        = left;
+        _right       = right;
+        _highlighted = highlighted;
+    }
+};
@@ -13,14 +13,7 @@ extern const char* git_info;
 
 extern AboutScene aboutScene;
 
-void setup() {
-    init_system();
-
-    display.setBrightness(aboutScene.getBrightness());
-
-    show_logo();
-    delay_ms(2000);  // view the logo and wait for the debug port to connect
-
+static void start_ui(void* arg) {
     base_display();
 
     dbg_printf("FluidNC Pendant %s\n", git_info);
@@ -33,7 +26,20 @@ void setup() {
     activate_scene(initMenus());
 }
 
+void setup() {
+    init_system();
+
+    display.setBrightness(aboutScene.getBrightness());
+
+    show_logo();
+    // View the logo and wait for the debug port to connect.  The loop
+    // runs meanwhile, but dispatches nothing until there is a scene.
+    set_timeout(2000, start_ui);
+}
+
 void loop() {
-    fnc_poll();         // Handle messages from FluidNC
+    if (current_scene) {
+        fnc_poll();  // Handle messages from FluidNC
+    }
     dispatch_events();  // Handle dial, touch, buttons
 }
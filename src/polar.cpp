@@ -0,0 +1,214 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Integer trig for converting between rectangular and polar coordinates,
+// useful for calculating circular layouts on a graphics screen.
+
+#include "polar.h"
+
+#include <stdint.h>
+
+// Sine of the first quarter circle at REVS_BITS resolution, scaled by
+// 1 << SINE_BITS and generated at compile time
+#define SINE_BITS 14
+#define QUARTER (1 << (REVS_BITS - 2))
+
+namespace {
+// C++11 has no std::index_sequence.  This one halves N at each level so
+// the template depth stays small for a 1025-entry table.
+template <int... I>
+struct seq {
+    typedef seq type;
+};
+template <class A, class B>
+struct concat;
+template <int... A, int... B>
+struct concat<seq<A...>, seq<B...>> : seq<A..., (int)sizeof...(A) + B...> {};
+template <int N>
+struct make_seq : concat<typename make_seq<N / 2>::type, typename make_seq<N - N / 2>::type> {};
+template <>
+struct make_seq<0> : seq<> {};
+template <>
+struct make_seq<1> : seq<0> {};
+
+// Taylor series, which converges within a quarter circle in 11 terms
+constexpr double taylor_sin(double x2, double term, int k) {
+    return k > 21 ? 0 : term + taylor_sin(x2, -term * x2 / ((k + 1) * (k + 2)), k + 2);
+}
+constexpr uint16_t quarter_sine(int i) {
+    return (uint16_t)(taylor_sin((i * 1.5707963267948966 / QUARTER) * (i * 1.5707963267948966 / QUARTER),
+                                 i * 1.5707963267948966 / QUARTER,
+                                 1) *
+                          (1 << SINE_BITS) +
+                      0.5);
+}
+
+template <class S>
+struct sine_table;
+template <int... I>
+struct sine_table<seq<I...>> {
+    static constexpr uint16_t values[] = { quarter_sine(I)... };
+};
+template <int... I>
+constexpr uint16_t sine_table<seq<I...>>::values[];
+
+const uint16_t* const sine = sine_table<make_seq<QUARTER + 1>::type>::values;
+
+// Tables of the first octant indexed by the ratio t = y/x in 1/256ths,
+// read with linear interpolation: the angle atan(t) in 1/16ths of the
+// REVS_BITS unit, and the magnitude factor sqrt(1 + t*t) - 1 in
+// 1/131072ths, which is at most 54290.  Interpolation is good to a small fraction of a unit.
+#define RATIO_STEPS 256
+#define FINE_BITS 4
+
+// Euler's series, which converges by at least a bit a term for t <= 1
+constexpr double euler_atan(double z, double term, int n) {
+    return n > 120 ? 0 : term + euler_atan(z, term * z * (2 * n + 2) / (2 * n + 3), n + 1);
+}
+constexpr double octant_atan(double t) {
+    return euler_atan(t * t / (1 + t * t), t / (1 + t * t), 0);
+}
+constexpr uint16_t ratio_angle(int i) {
+    return (uint16_t)(octant_atan((double)i / RATIO_STEPS) / (2 * 3.141592653589793) * (1 << (REVS_BITS + FINE_BITS)) + 0.5);
+}
+
+constexpr double newton_sqrt(double v, double guess, int n) {
+    return n == 0 ? guess : newton_sqrt(v, (guess + v / guess) / 2, n - 1);
+}
+constexpr uint16_t ratio_magnitude(int i) {
+    return (uint16_t)((newton_sqrt(1 + (double)i * i / (RATIO_STEPS * RATIO_STEPS), 1.2, 8) - 1) * 131072 + 0.5);
+}
+
+template <class S>
+struct ratio_tables;
+template <int... I>
+struct ratio_tables<seq<I...>> {
+    static constexpr uint16_t angles[]     = { ratio_angle(I)... };
+    static constexpr uint16_t magnitudes[] = { ratio_magnitude(I)... };
+};
+template <int... I>
+constexpr uint16_t ratio_tables<seq<I...>>::angles[];
+template <int... I>
+constexpr uint16_t ratio_tables<seq<I...>>::magnitudes[];
+
+typedef ratio_tables<make_seq<RATIO_STEPS + 1>::type> ratio_table;
+}
+
+// The angle is scaled such that (1 << REVS_BITS) represents a full
+// revolution.  Angles outside one revolution wrap.
+void r_revs_to_xy(int radius, int angle, int* px, int* py) {
+    int i = angle & (QUARTER - 1);
+    int s, c;
+    switch ((angle >> (REVS_BITS - 2)) & 3) {
+        case 0:
+            s = sine[i];
+            c = sine[QUARTER - i];
+            break;
+        case 1:
+            s = sine[QUARTER - i];
+            c = -sine[i];
+            break;
+        case 2:
+            s = -sine[i];
+            c = -sine[QUARTER - i];
+            break;
+        default:
+            s = -sine[QUARTER - i];
+            c = sine[i];
+            break;
+    }
+    const int half = 1 << (SINE_BITS - 1);
+    *px            = (radius * c + half) >> SINE_BITS;
+    *py            = (radius * s + half) >> SINE_BITS;
+}
+
+void r_degrees_to_xy(int radius, int degrees, int* px, int* py) {
+    return r_revs_to_xy(radius, to_revs(degrees, 360), px, py);
+}
+
+// The result is scaled by the radius. E.g. if degrees is 45,
+// for a slope of 1, the return value is radius.
+int r_degrees_to_slope(int radius, int degrees) {
+    int x, y;
+    r_degrees_to_xy(radius, degrees, &x, &y);
+    if (x == 0) {
+        x = 1;
+    }
+    return y * radius / x;
+}
+
+// y/x for 0 <= y <= x < 65536, x > 0, in 1/65536ths.  Large values are
+// scaled down so the quotient fits in 32 bits; that costs no accuracy
+// that the tables could use.
+static uint32_t ratio(uint32_t x, uint32_t y) {
+    while (x >= 32768) {
+        x >>= 1;
+        y >>= 1;
+    }
+    return ((y << 16) + (x >> 1)) / x;
+}
+
+// Reads a ratio table at a ratio from ratio()
+static int interpolate(const uint16_t* table, uint32_t r) {
+    uint32_t i = r >> 8;
+    uint32_t f = r & 0xff;
+    if (i == RATIO_STEPS) {
+        return table[RATIO_STEPS];
+    }
+    return table[i] + (((table[i + 1] - table[i]) * f + 0x80) >> 8);
+}
+
+// Angle of (x, |y|), in 1/16ths of the REVS_BITS unit, from the first
+// octant by symmetry
+static int fine_atan2(int x, int y) {
+    uint32_t ax = x < 0 ? -x : x;
+    uint32_t ay = y < 0 ? -y : y;
+    bool     steep = ay > ax;
+    if (steep) {
+        uint32_t t = ax;
+        ax         = ay;
+        ay         = t;
+    }
+    int a = ax ? interpolate(ratio_table::angles, ratio(ax, ay)) : 0;
+    if (steep) {
+        a = (QUARTER << FINE_BITS) - a;
+    }
+    if (x < 0) {
+        a = (QUARTER * 2 << FINE_BITS) - a;
+    }
+    return a;
+}
+
+// XY to angle, result in revs (1 << REVS_BITS is a full circle)
+int iatan2(int x, int y) {
+    int revs = (fine_atan2(x, y) + (1 << (FINE_BITS - 1))) >> FINE_BITS;
+    return y < 0 ? -revs : revs;
+}
+
+// XY to angle, result in degrees
+int iatan2_degrees(int x, int y) {
+    const int bits    = REVS_BITS + FINE_BITS;
+    int       degrees = (fine_atan2(x, y) * 360 + (1 << (bits - 1))) >> bits;
+    return y < 0 ? -degrees : degrees;
+}
+
+// sqrt(x*x + y*y) for |x|, |y| < 65536, as x * sqrt(1 + (y/x)^2).  The
+// error is at most 0.6 below 8192, growing to 2 at the top of the range.
+int imagnitude(int x, int y) {
+    uint32_t ax = x < 0 ? -x : x;
+    uint32_t ay = y < 0 ? -y : y;
+    if (ay > ax) {
+        uint32_t t = ax;
+        ax         = ay;
+        ay         = t;
+    }
+    if (ax == 0) {
+        return 0;
+    }
+    return ax + ((ax * interpolate(ratio_table::magnitudes, ratio(ax, ay)) + 0x10000) >> 17);
+}
+
+void xy_to_r_degrees(int x, int y, int* radius, int* degrees) {
+    *degrees = iatan2_degrees(x, y);
+    *radius  = imagnitude(x, y);
+}
@@ -20,7 +20,8 @@ inline int to_revs(int num, int denom) {
 void r_revs_to_xy(int radius, int angle, int* px, int* py);
 void r_degrees_to_xy(int radius, int degrees, int* px, int* py);
 int  r_degrees_to_slope(int radius, int degrees);
-int  iatan2(int x, int y);
+int  iatan2(int x, int y);  // Result in revs
+int  iatan2_degrees(int x, int y);
 int  imagnitude(int x, int y);
 void xy_to_r_degrees(int x, int y, int* radius, int* theta);
 
@@ -0,0 +1,142 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Accuracy of the integer trig in polar.cpp against libm, and its speed.
+// Run on the host with "pio test -e native".
+
+#include <unity.h>
+#include "polar.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+
+void setUp() {}
+void tearDown() {}
+
+static double angle_error(double a, double b) {
+    double e = std::fabs(a - b);
+    return e > 180 ? 360 - e : e;
+}
+
+// Every angle at the radii the layouts use, and a large one
+void test_revs_to_xy() {
+    double worst = 0;
+    for (int r : { 10, 50, 110, 114, 120, 1024 }) {
+        for (int a = 0; a < (1 << REVS_BITS); a++) {
+            double th = a * 2 * M_PI / (1 << REVS_BITS);
+            int    x, y;
+            r_revs_to_xy(r, a, &x, &y);
+            worst = std::fmax(worst, std::fmax(std::fabs(x - r * cos(th)), std::fabs(y - r * sin(th))));
+        }
+    }
+    TEST_ASSERT_TRUE(worst < 0.55);
+}
+
+void test_revs_wrap() {
+    int x0, y0, x1, y1;
+    r_revs_to_xy(100, 100, &x0, &y0);
+    r_revs_to_xy(100, 100 + (1 << REVS_BITS), &x1, &y1);
+    TEST_ASSERT_EQUAL_INT(x0, x1);
+    TEST_ASSERT_EQUAL_INT(y0, y1);
+    r_revs_to_xy(100, 100 - (1 << REVS_BITS), &x1, &y1);
+    TEST_ASSERT_EQUAL_INT(x0, x1);
+    TEST_ASSERT_EQUAL_INT(y0, y1);
+}
+
+// Every point of a 301 x 301 square around the origin
+void test_atan2_and_magnitude() {
+    double worst_degrees = 0;
+    double worst_revs    = 0;
+    double worst_mag     = 0;
+    for (int y = -150; y <= 150; y++) {
+        for (int x = -150; x <= 150; x++) {
+            if (!x && !y) {
+                continue;
+            }
+            double degrees = atan2(y, x) * 180 / M_PI;
+            worst_degrees  = std::fmax(worst_degrees, angle_error(iatan2_degrees(x, y), degrees));
+            worst_revs     = std::fmax(worst_revs, angle_error(iatan2(x, y) * 360.0 / (1 << REVS_BITS), degrees));
+            worst_mag      = std::fmax(worst_mag, std::fabs(imagnitude(x, y) - std::hypot(x, y)));
+        }
+    }
+    TEST_ASSERT_TRUE(worst_degrees < 0.51);
+    TEST_ASSERT_TRUE(worst_revs < 0.05);
+    TEST_ASSERT_TRUE(worst_mag < 0.51);
+}
+
+void test_large_values() {
+    TEST_ASSERT_EQUAL_INT(0, imagnitude(0, 0));
+    TEST_ASSERT_EQUAL_INT(65535, imagnitude(65535, 0));
+    TEST_ASSERT_EQUAL_INT(65535, imagnitude(0, -65535));
+    TEST_ASSERT_INT_WITHIN(2, 92680, imagnitude(65535, 65535));
+    TEST_ASSERT_INT_WITHIN(1, 5000, imagnitude(3000, -4000));
+    TEST_ASSERT_EQUAL_INT(45, iatan2_degrees(65535, 65535));
+    TEST_ASSERT_EQUAL_INT(-135, iatan2_degrees(-40000, -40000));
+    TEST_ASSERT_EQUAL_INT(180, iatan2_degrees(-1, 0));
+    TEST_ASSERT_EQUAL_INT(90, iatan2_degrees(0, 7));
+}
+
+void test_round_trip() {
+    for (int degrees = -179; degrees <= 180; degrees++) {
+        int x, y, r, d;
+        r_degrees_to_xy(1000, degrees, &x, &y);
+        xy_to_r_degrees(x, y, &r, &d);
+        TEST_ASSERT_INT_WITHIN(1, 1000, r);
+        TEST_ASSERT_INT_WITHIN(1, degrees, d);
+    }
+}
+
+static volatile int sink;
+
+template <typename F>
+static double ns_per_call(F f) {
+    const int n  = 2000000;
+    auto      t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        f(i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+}
+
+// Reports times next to libm for reference; it checks nothing
+void test_benchmark() {
+    char line[100];
+    snprintf(line,
+             sizeof(line),
+             "r_revs_to_xy %.1f ns, cos+sin %.1f ns",
+             ns_per_call([](int i) {
+                 int x, y;
+                 r_revs_to_xy(114, i & 4095, &x, &y);
+                 sink = x + y;
+             }),
+             ns_per_call([](int i) {
+                 double th = (i & 4095) * (2 * M_PI / 4096);
+                 sink      = (int)(114 * cos(th)) + (int)(114 * sin(th));
+             }));
+    TEST_MESSAGE(line);
+    snprintf(line,
+             sizeof(line),
+             "iatan2_degrees %.1f ns, atan2 %.1f ns",
+             ns_per_call([](int i) { sink = iatan2_degrees((i % 301) - 150, ((i / 301) % 301) - 150); }),
+             ns_per_call([](int i) { sink = (int)(atan2((i / 301) % 301 - 150, i % 301 - 150) * 180 / M_PI); }));
+    TEST_MESSAGE(line);
+    snprintf(line,
+             sizeof(line),
+             "imagnitude %.1f ns, hypot %.1f ns",
+             ns_per_call([](int i) { sink = imagnitude((i % 301) - 150, ((i / 301) % 301) - 150); }),
+             ns_per_call([](int i) { sink = (int)std::hypot(i % 301 - 150, (i / 301) % 301 - 150); }));
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_revs_to_xy);
+    RUN_TEST(test_revs_wrap);
+    RUN_TEST(test_atan2_and_magnitude);
+    RUN_TEST(test_large_values);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+// Copyright (c) 2024 - Mitch Bradley
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Coverage of the ring and arc spans in Spans.h, checked pixel by pixel,
+// and their speed against stacked one-pixel circles, which is how thick
+// circles were drawn before.  Run on the host with "pio test -e native".
+
+#include <unity.h>
+#include "Spans.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+void setUp() {}
+void tearDown() {}
+
+static const int size   = 240;
+static const int center = size / 2;
+static uint8_t   pixels[size * size];
+static int       calls;
+
+static void put_pixel(int x, int y) {
+    ++calls;
+    if (x >= 0 && x < size && y >= 0 && y < size) {
+        pixels[y * size + x] = 1;
+    }
+}
+
+struct buffer_fill {
+    void operator()(int dy, int left, int right) const {
+        ++calls;
+        int y = center + dy;
+        int l = std::max(0, center + left);
+        int r = std::min(size, center + right + 1);
+        if (y >= 0 && y < size && r > l) {
+            memset(pixels + y * size + l, 1, r - l);
+        }
+    }
+};
+
+// The midpoint circle of LovyanGFX drawCircle()
+static void midpoint_circle(int r) {
+    int f = 1 - r, ddx = 1, ddy = -2 * r, x = 0, y = r;
+    put_pixel(center, center + r);
+    put_pixel(center, center - r);
+    put_pixel(center + r, center);
+    put_pixel(center - r, center);
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddy += 2;
+            f += ddy;
+        }
+        x++;
+        ddx += 2;
+        f += ddx;
+        put_pixel(center + x, center + y);
+        put_pixel(center - x, center + y);
+        put_pixel(center + x, center - y);
+        put_pixel(center - x, center - y);
+        put_pixel(center + y, center + x);
+        put_pixel(center - y, center + x);
+        put_pixel(center + y, center - x);
+        put_pixel(center - y, center - x);
+    }
+}
+
+static void clear() {
+    memset(pixels, 0, sizeof(pixels));
+    calls = 0;
+}
+
+static bool in_ring(int dx, int dy, int outer, int inner) {
+    int d2 = dx * dx + dy * dy;
+    return d2 <= outer * outer + outer && (inner <= 0 || d2 > (inner - 1) * (inner - 1) + (inner - 1));
+}
+
+void test_ring_coverage() {
+    for (int inner : { 0, 1, 91, 108 }) {
+        clear();
+        ring_spans(119, inner, buffer_fill());
+        int wrong = 0;
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                wrong += in_ring(x - center, y - center, 119, inner) != (pixels[y * size + x] == 1);
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(0, wrong);
+    }
+}
+
+// Pixels on the bounding rays can go either way, so angles within
+// 0.05 degrees of them are not counted
+void test_arc_coverage() {
+    const int arcs[][2] = { { -50, 50 }, { 0, 360 }, { 200, 10 }, { 90, 91 } };
+    for (auto const& arc : arcs) {
+        clear();
+        arc_spans(119, 108, arc[0], arc[1], buffer_fill());
+        int wrong = 0;
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                int dx = x - center;
+                int dy = y - center;
+                if (!in_ring(dx, dy, 119, 108)) {
+                    wrong += pixels[y * size + x];
+                    continue;
+                }
+                double a = atan2(dy, dx) * 180 / M_PI - arc[0];
+                int    n = arc[1] - arc[0];
+                while (n < 0) {
+                    n += 360;
+                }
+                while (a < -0.05) {
+                    a += 360;
+                }
+                if (std::fabs(a) < 0.05 || std::fabs(a - n) < 0.05 || std::fabs(a - 360) < 0.05) {
+                    continue;
+                }
+                wrong += (a <= n) != (pixels[y * size + x] == 1);
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(0, wrong);
+    }
+}
+
+// Five stacked circles leave gaps that a ring does not
+void test_stacked_circles_have_holes() {
+    clear();
+    for (int i = 0; i < 5; i++) {
+        midpoint_circle(95 - i);
+    }
+    int holes = 0;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int d2 = (x - center) * (x - center) + (y - center) * (y - center);
+            holes += d2 <= 94 * 94 && d2 >= 92 * 92 && !pixels[y * size + x];
+        }
+    }
+    TEST_ASSERT_TRUE(holes > 0);
+}
+
+template <typename F>
+static double us_per_call(F f) {
+    const int n  = 20000;
+    auto      t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        f();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / n;
+}
+
+static void five_circles() {
+    for (int i = 0; i < 5; i++) {
+        midpoint_circle(95 - i);
+    }
+}
+static void five_pixel_ring() {
+    ring_spans(95, 91, buffer_fill());
+}
+static void scroll_track() {
+    arc_spans(119, 108, -50, 50, buffer_fill());
+}
+
+// Reports times and drawing calls; it checks nothing.  On the host a
+// pixel write costs next to nothing, so the call counts say more about
+// the device, where every call pays for clipping and dispatch.
+void test_benchmark() {
+    char line[100];
+    clear();
+    five_circles();
+    int circle_calls = calls;
+    clear();
+    five_pixel_ring();
+    int ring_calls = calls;
+    clear();
+    scroll_track();
+    int arc_calls = calls;
+
+    snprintf(line, sizeof(line), "5 px ring: 5 circles %.2f us, %d calls", us_per_call(five_circles), circle_calls);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "5 px ring: ring_spans %.2f us, %d calls", us_per_call(five_pixel_ring), ring_calls);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "scroll track: arc_spans %.2f us, %d calls", us_per_call(scroll_track), arc_calls);
+    TEST_MESSAGE(line);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ring_coverage);
+    RUN_TEST(test_arc_coverage);
+    RUN_TEST(test_stacked_circles_have_holes);
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}